@@ -0,0 +1,44 @@
+# Writes OUTPUT_FILE, defining OBXF_BUILD_IDENTITY as the commit being built plus a hash of
+# any uncommitted changes to it. Run on every build by the obxf-build-identity target; the
+# file is only rewritten when the identity changes, so nothing rebuilds needlessly.
+#
+# Expects SOURCE_DIR, VERSION and OUTPUT_FILE to be set with -D.
+
+execute_process(
+    COMMAND git rev-parse HEAD
+    WORKING_DIRECTORY ${SOURCE_DIR}
+    OUTPUT_VARIABLE commit
+    OUTPUT_STRIP_TRAILING_WHITESPACE
+    RESULT_VARIABLE result
+    ERROR_QUIET
+)
+
+if(result EQUAL 0)
+    execute_process(
+        COMMAND git diff HEAD
+        WORKING_DIRECTORY ${SOURCE_DIR}
+        OUTPUT_VARIABLE changes
+        ERROR_QUIET
+    )
+
+    set(identity "${commit}")
+
+    if(NOT changes STREQUAL "")
+        string(SHA1 changesHash "${changes}")
+        set(identity "${identity}-dirty-${changesHash}")
+    endif()
+else()
+    # a source tarball, which can only change with its version
+    set(identity "${VERSION}")
+endif()
+
+set(content "#define OBXF_BUILD_IDENTITY \"${identity}\"\n")
+set(previous "")
+
+if(EXISTS ${OUTPUT_FILE})
+    file(READ ${OUTPUT_FILE} previous)
+endif()
+
+if(NOT content STREQUAL previous)
+    file(WRITE ${OUTPUT_FILE} "${content}")
+endif()
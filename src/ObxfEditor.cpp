@@ -23,6 +23,7 @@
 #include "components/ScalingImageCache.h"
 
 #include "gui/AboutScreen.h"
+#include "gui/PatchBrowser.h"
 #include "gui/SaveDialog.h"
 
 #include "gui/FocusDebugger.h"
@@ -69,7 +70,7 @@ ObxfAudioProcessorEditor::ObxfAudioProcessorEditor(ObxfAudioProcessor &p)
     });
     keyCommandHandler->setRefreshThemeCallback([this]() {
         clean();
-        loadTheme(processor);
+        loadTheme(processor, true);
     });
 
     commandManager.registerAllCommandsForTarget(keyCommandHandler.get());
@@ -83,6 +84,9 @@ ObxfAudioProcessorEditor::ObxfAudioProcessorEditor(ObxfAudioProcessor &p)
     saveDialog = std::make_unique<SaveDialog>(*this);
     addChildComponent(*saveDialog);
 
+    patchBrowser = std::make_unique<PatchBrowser>(*this);
+    addChildComponent(*patchBrowser);
+
     const auto jersey = juce::Typeface::createSystemTypefaceFor(BinaryData::Jersey20_ttf,
                                                                 BinaryData::Jersey20_ttfSize);
     const auto trek =
@@ -292,12 +296,51 @@ void ObxfAudioProcessorEditor::resized()
         saveDialog->resized();
     }
 
+    if (patchBrowser)
+    {
+        patchBrowser->setBounds(getBounds());
+    }
+
     if (updateProcessorImpliedScaleFactor)
     {
         processor.lastImpliedScaleFactor = impliedScaleFactor();
     }
 }
 
+void ObxfAudioProcessorEditor::toggleDspLoadDisplay()
+{
+    if (!dspLoadLabel)
+    {
+        dspLoadLabel = std::make_unique<juce::Label>();
+        dspLoadLabel->setInterceptsMouseClicks(false, false);
+        dspLoadLabel->setColour(juce::Label::backgroundColourId,
+                                juce::Colours::black.withAlpha(0.6f));
+        dspLoadLabel->setColour(juce::Label::textColourId, juce::Colours::white);
+        addChildComponent(*dspLoadLabel);
+    }
+
+    dspLoadLabel->setVisible(!dspLoadLabel->isVisible());
+    updateDspLoadDisplay();
+}
+
+void ObxfAudioProcessorEditor::updateDspLoadDisplay()
+{
+    if (!dspLoadLabel || !dspLoadLabel->isVisible())
+    {
+        return;
+    }
+
+    const auto s = processor.getDspLoadMeter().snapshot();
+
+    dspLoadLabel->setText(fmt::format("DSP Load: {:.1f}% mean, {:.1f}% p99, {:.1f}% max | {} "
+                                      "voices | {}",
+                                      s.mean * 100.f, s.p99 * 100.f, s.max * 100.f,
+                                      s.soundingVoices, s.highQuality ? "HQ" : "LQ"),
+                          juce::dontSendNotification);
+    dspLoadLabel->setBounds(0, 0, getWidth(), 20);
+    dspLoadLabel->toFront(false);
+}
+
 void ObxfAudioProcessorEditor::idle()
 {
     if (!skinLoaded)
@@ -327,6 +370,7 @@ void ObxfAudioProcessorEditor::idle()
         }
 
         updateSelectButtonStates();
+        updateDspLoadDisplay();
         countTimer = 0;
     }
 
@@ -854,20 +898,29 @@ bool ObxfAudioProcessorEditor::isInterestedInFileDrag(const juce::StringArray &f
 
 void ObxfAudioProcessorEditor::filesDropped(const juce::StringArray &files, int /*x*/, int /*y*/)
 {
-    // we will take only the first file from the drop
-    if (files.size() > 0)
+    // banks are all imported together, otherwise we will take only the first file from the drop
+    juce::Array<juce::File> banks;
+
+    for (const auto &f : files)
+    {
+        if (const juce::File file(f); file.getFileExtension().toLowerCase() == ".fxb")
+        {
+            banks.add(file);
+        }
+    }
+
+    if (!banks.isEmpty())
+    {
+        importObxdBanks(banks);
+    }
+    else if (files.size() > 0)
     {
         const auto file = juce::File(files[0]);
-        const juce::String ext = file.getFileExtension().toLowerCase();
 
-        if (ext == ".fxp")
+        if (file.getFileExtension().toLowerCase() == ".fxp")
         {
             utils.loadPatch(file);
         }
-        else if (ext == ".fxb")
-        {
-            importObxdBank(file);
-        }
     }
 }
 #endif
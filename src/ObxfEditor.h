@@ -30,6 +30,7 @@
 #include "gui/Display.h"
 #include "gui/Label.h"
 #include "components/ScalingImageCache.h"
+#include "components/ThemeLayout.h"
 #include "Constants.h"
 #include "Utils.h"
 #include "KeyCommandHandler.h"
@@ -47,6 +48,7 @@
 
 struct AboutScreen;
 struct SaveDialog;
+struct PatchBrowser;
 struct FocusDebugger;
 
 using KnobAttachment = Attachment<Knob, true>;
@@ -97,7 +99,7 @@ class ObxfAudioProcessorEditor final : public juce::AudioProcessorEditor,
 #include "editor/ObxfEditorTheme.h"
 
     std::unique_ptr<juce::Timer> idleTimer;
-    std::unique_ptr<juce::XmlElement> cachedThemeXml;
+    std::shared_ptr<const ThemeLayout> cachedThemeLayout;
 
     std::unique_ptr<juce::ComponentBoundsConstrainer> constrainer;
     ObxfAudioProcessor &processor;
@@ -152,6 +154,10 @@ class ObxfAudioProcessorEditor final : public juce::AudioProcessorEditor,
     bool ignoreHostScale{false};
     bool dontParentMenusToEditor{false};
 
+    std::unique_ptr<juce::Label> dspLoadLabel;
+    void toggleDspLoadDisplay();
+    void updateDspLoadDisplay();
+
     void initializeEditorCallbacks();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ObxfAudioProcessorEditor)
@@ -19,6 +19,7 @@
 #include "ObxfEditor.h"
 #include "ObxfProcessor.h"
 #include "Constants.h"
+#include "RealtimeScope.h"
 #include "sst/plugininfra/version_information.h"
 
 #if OBLOG_TO_FILE
@@ -35,7 +36,7 @@ ObxfAudioProcessor::ObxfAudioProcessor()
                          .withOutput("Output", juce::AudioChannelSet::stereo(), true)
 #endif
                          ),
-      utils(std::make_unique<Utils>()),
+      utils(std::make_unique<Utils>()), shadowSynth(std::make_unique<SynthEngine>()),
       paramCoordinator(std::make_unique<ParameterCoordinator>(*this, *this, *this, synth)),
       paramAlgos(std::make_unique<ParameterAlgos>(*paramCoordinator, *utils)),
       midiHandler(synth, bindings, *paramCoordinator, *this),
@@ -61,8 +62,34 @@ ObxfAudioProcessor::ObxfAudioProcessor()
         supportEdgePrograms = false;
     }
 
+    hqModeParamIndex = parameterListIndexOf(ID::HQMode);
+    bendUpParamIndex = parameterListIndexOf(ID::BendUpRange);
+    bendDownParamIndex = parameterListIndexOf(ID::BendDownRange);
+
+    for (auto *p : getParameters())
+    {
+        if (auto *withID = dynamic_cast<juce::AudioProcessorParameterWithID *>(p))
+        {
+            clapParameters[static_cast<clap_id>(withID->paramID.hashCode())] = p;
+        }
+    }
+
+    addListener(this);
+
+    // crossfaded tails keep following MTS-ESP through the main engine's client
+    shadowSynth->getMotherboard()->shareTuning(synth.getMotherboard()->tuning);
+
     initializeCallbacks();
 
+    // utils scanned the patch tree before our callbacks were hooked up
+    prepareMidiProgramBank();
+
+    // headless processors have no message loop to poll in, OfflineRenderer takes over there
+    if (juce::MessageManager::getInstanceWithoutCreating() != nullptr)
+    {
+        startTimerHz(handoverPollHz);
+    }
+
     juce::PropertiesFile::Options options;
     options.applicationName = JucePlugin_Name;
     options.storageFormat = juce::PropertiesFile::storeAsXML;
@@ -81,7 +108,11 @@ ObxfAudioProcessor::ObxfAudioProcessor()
 }
 #endif
 
-ObxfAudioProcessor::~ObxfAudioProcessor() = default;
+ObxfAudioProcessor::~ObxfAudioProcessor()
+{
+    stopTimer();
+    removeListener(this);
+}
 
 void ObxfAudioProcessor::prepareToPlay(const double sampleRate, const int /*samplesPerBlock*/)
 {
@@ -93,12 +124,283 @@ void ObxfAudioProcessor::prepareToPlay(const double sampleRate, const int /*samp
 
     synth.setSampleRate(static_cast<float>(sampleRate));
     midiHandler.setSampleRate(sampleRate);
+
+    shadowSynth->setSampleRate(static_cast<float>(sampleRate));
+    shadowActive = false;
+    midiHandler.setShadowEngine(nullptr);
+    dspLoad.reset();
+    clapMidi.ensureSize(clapMidiBytes);
+
+    // without a host transport the LFO sync position starts over
+    wasPlayingLastFrame = false;
+    lastPPQPosition = -1;
+    syntheticPPQPosition = -1;
+
+    tailLengthSeconds.store(synth.getReleaseTailSeconds(), std::memory_order_relaxed);
 }
 
 void ObxfAudioProcessor::processBlock(juce::AudioBuffer<float> &buffer,
                                       juce::MidiBuffer &midiMessages)
+{
+    juce::Optional<juce::AudioPlayHead::PositionInfo> position;
+
+    if (const auto *playHead = getPlayHead())
+    {
+        position = playHead->getPosition();
+    }
+
+    renderBlock(buffer, midiMessages, position);
+
+    // one more wrapper block which has sent outbound parameter events to the host
+    for (auto owed = clapWrapperBlocks.load(std::memory_order_acquire);
+         owed > 0 && !clapWrapperBlocks.compare_exchange_weak(owed, owed - 1);)
+    {
+    }
+}
+
+namespace
+{
+// set while the audio thread applies a host's parameter event, which the host already knows
+thread_local bool applyingClapParameter{false};
+
+// as the JUCE wrappers do it, so listeners only hear about actual changes
+void setValueAndNotifyIfChanged(juce::AudioProcessorParameter &param, float value)
+{
+    if (param.getValue() == value)
+        return;
+
+    const juce::ScopedValueSetter<bool> fromHost(applyingClapParameter, true);
+
+    param.setValue(value);
+    param.sendValueChangedMessageToListeners(value);
+}
+
+uint8_t clapNoteChannel(int16_t channel)
+{
+    return static_cast<uint8_t>(channel < 0 ? 0 : channel & 0xF);
+}
+
+void addClapMidi(juce::MidiBuffer &midi, uint8_t status, uint8_t channel, int data1, int data2,
+                 int time)
+{
+    const uint8_t msg[3]{static_cast<uint8_t>(status | channel),
+                         static_cast<uint8_t>(data1 & 0x7F), static_cast<uint8_t>(data2 & 0x7F)};
+    midi.addEvent(msg, 3, time);
+}
+} // namespace
+
+void ObxfAudioProcessor::requireClapWrapper()
+{
+    if (!applyingClapParameter)
+    {
+        clapWrapperBlocks.store(clapOutboundDrainBlocks, std::memory_order_release);
+    }
+}
+
+void ObxfAudioProcessor::audioProcessorParameterChanged(juce::AudioProcessor *, int, float)
+{
+    requireClapWrapper();
+}
+
+void ObxfAudioProcessor::audioProcessorParameterChangeGestureBegin(juce::AudioProcessor *, int)
+{
+    requireClapWrapper();
+}
+
+void ObxfAudioProcessor::audioProcessorParameterChangeGestureEnd(juce::AudioProcessor *, int)
+{
+    requireClapWrapper();
+}
+
+clap_process_status ObxfAudioProcessor::clap_direct_process(const clap_process *process) noexcept
+{
+    if (process->audio_outputs_count == 0 || process->audio_outputs[0].channel_count == 0 ||
+        process->frames_count == 0)
+        return CLAP_PROCESS_CONTINUE;
+
+    const auto numSamples = static_cast<int>(process->frames_count);
+    const auto *events = process->in_events;
+    const auto numEvents = events->size(events);
+
+    juce::Optional<juce::AudioPlayHead::PositionInfo> position;
+
+    if (const auto *transport = process->transport)
+    {
+        juce::AudioPlayHead::PositionInfo info;
+
+        if (transport->flags & CLAP_TRANSPORT_HAS_TEMPO)
+        {
+            info.setBpm(transport->tempo);
+        }
+
+        if (transport->flags & CLAP_TRANSPORT_HAS_BEATS_TIMELINE)
+        {
+            info.setPpqPosition(static_cast<double>(transport->song_pos_beats) /
+                                static_cast<double>(CLAP_BEATTIME_FACTOR));
+        }
+
+        info.setIsPlaying((transport->flags & CLAP_TRANSPORT_IS_PLAYING) != 0);
+        position = info;
+    }
+
+    auto &out = process->audio_outputs[0];
+    const auto numChannels = juce::jmin(2, static_cast<int>(out.channel_count));
+
+    int pos{0};
+    bool silent{true};
+
+    // parameter events cut the block, so each lands on its own sample
+    const auto renderUpTo = [&](int end) {
+        if (end <= pos)
+            return;
+
+        float *channels[2]{};
+
+        for (int c = 0; c < numChannels; ++c)
+            channels[c] = out.data32[c] + pos;
+
+        auto segmentPosition = position;
+
+        if (segmentPosition && pos > 0 && segmentPosition->getBpm() &&
+            segmentPosition->getPpqPosition())
+        {
+            segmentPosition->setPpqPosition(*segmentPosition->getPpqPosition() +
+                                            pos * *segmentPosition->getBpm() /
+                                                (60.0 * getSampleRate()));
+        }
+
+        juce::AudioBuffer<float> segment(channels, numChannels, end - pos);
+        silent = renderBlock(segment, clapMidi, segmentPosition) && silent;
+
+        clapMidi.clear();
+        pos = end;
+    };
+
+    clapMidi.clear();
+
+    for (uint32_t i = 0; i < numEvents; ++i)
+    {
+        const auto *ev = events->get(events, i);
+
+        if (ev->space_id != CLAP_CORE_EVENT_SPACE_ID)
+            continue;
+
+        const auto time = juce::jlimit(pos, numSamples - 1, static_cast<int>(ev->time));
+
+        switch (ev->type)
+        {
+        case CLAP_EVENT_NOTE_ON:
+        {
+            const auto *note = reinterpret_cast<const clap_event_note *>(ev);
+
+            if (note->key >= 0)
+            {
+                // a note on with zero velocity would be a note off
+                const auto velocity = juce::jlimit(1, 127, juce::roundToInt(note->velocity * 127));
+                addClapMidi(clapMidi, 0x90, clapNoteChannel(note->channel), note->key, velocity,
+                            time - pos);
+            }
+            break;
+        }
+        case CLAP_EVENT_NOTE_OFF:
+        case CLAP_EVENT_NOTE_CHOKE:
+        {
+            const auto *note = reinterpret_cast<const clap_event_note *>(ev);
+
+            if (note->key >= 0)
+            {
+                const auto velocity = juce::jlimit(0, 127, juce::roundToInt(note->velocity * 127));
+                addClapMidi(clapMidi, 0x80, clapNoteChannel(note->channel), note->key, velocity,
+                            time - pos);
+            }
+            else
+            {
+                // every key, on every channel for a wildcard one: all notes off releases
+                // them, all sound off cuts them
+                const auto cc = ev->type == CLAP_EVENT_NOTE_CHOKE ? 120 : 123;
+                const int first = clapNoteChannel(note->channel);
+                const int last = note->channel < 0 ? 15 : first;
+
+                for (int ch = first; ch <= last; ++ch)
+                    addClapMidi(clapMidi, 0xB0, static_cast<uint8_t>(ch), cc, 0, time - pos);
+            }
+            break;
+        }
+        case CLAP_EVENT_NOTE_EXPRESSION:
+        {
+            // onto the note's channel, as the MPE messages the engine already follows; volume,
+            // pan, vibrato and expression have no per note destination in the engine
+            const auto *ne = reinterpret_cast<const clap_event_note_expression *>(ev);
+
+            if (ne->channel < 0)
+                break;
+
+            if (ne->expression_id == CLAP_NOTE_EXPRESSION_PRESSURE)
+            {
+                const uint8_t msg[2]{static_cast<uint8_t>(0xD0 | clapNoteChannel(ne->channel)),
+                                     static_cast<uint8_t>(juce::jlimit(
+                                         0, 127, juce::roundToInt(ne->value * 127)))};
+                clapMidi.addEvent(msg, 2, time - pos);
+            }
+            else if (ne->expression_id == CLAP_NOTE_EXPRESSION_BRIGHTNESS)
+            {
+                addClapMidi(clapMidi, 0xB0, clapNoteChannel(ne->channel), 74,
+                            juce::jlimit(0, 127, juce::roundToInt(ne->value * 127)), time - pos);
+            }
+            else if (ne->expression_id == CLAP_NOTE_EXPRESSION_TUNING &&
+                     midiHandler.mpeEnabled.load(std::memory_order_relaxed))
+            {
+                const auto range = juce::jmax(1, midiHandler.mpePitchBendRange.load());
+                const auto bend = juce::jlimit(
+                    0, 16383, juce::roundToInt(8192.0 + ne->value / range * 8192.0));
+                addClapMidi(clapMidi, 0xE0, clapNoteChannel(ne->channel), bend & 0x7F, bend >> 7,
+                            time - pos);
+            }
+            break;
+        }
+        case CLAP_EVENT_MIDI:
+        {
+            const auto *midi = reinterpret_cast<const clap_event_midi *>(ev);
+            clapMidi.addEvent(midi->data,
+                              juce::MidiMessage::getMessageLengthFromFirstByte(midi->data[0]),
+                              time - pos);
+            break;
+        }
+        case CLAP_EVENT_PARAM_VALUE:
+        {
+            // reaches the engine through the parameter FIFO at the start of the next segment
+            const auto *pv = reinterpret_cast<const clap_event_param_value *>(ev);
+
+            if (auto found = clapParameters.find(pv->param_id); found != clapParameters.end())
+            {
+                renderUpTo(time);
+                setValueAndNotifyIfChanged(*found->second, static_cast<float>(pv->value));
+            }
+            break;
+        }
+        default:
+            break;
+        }
+    }
+
+    renderUpTo(numSamples);
+
+    out.constant_mask = silent ? ~uint64_t{0} : 0;
+
+    // a key came down during the block, so the wrapper takes over again
+    if (synth.isHeld())
+        return CLAP_PROCESS_CONTINUE;
+
+    return silent ? CLAP_PROCESS_SLEEP : CLAP_PROCESS_TAIL;
+}
+
+bool ObxfAudioProcessor::renderBlock(
+    juce::AudioBuffer<float> &buffer, juce::MidiBuffer &midiMessages,
+    const juce::Optional<juce::AudioPlayHead::PositionInfo> &position)
 {
     juce::ScopedNoDenormals noDenormals;
+    obxf::realtime::Scope realtimeScope;
+    dspLoad.beginBlock();
 
     paramCoordinator->getParameterUpdateHandler().updateParameters();
 
@@ -122,26 +424,23 @@ void ObxfAudioProcessor::processBlock(juce::AudioBuffer<float> &buffer,
     float *channelData2 = (buffer.getNumChannels() > 1) ? buffer.getWritePointer(1) : channelData1;
 
     bool gotTransportInfo{false};
-    if (const auto *playHead = getPlayHead())
+    if (position)
     {
-        if (auto position = playHead->getPosition())
+        if (position->getBpm() && position->getPpqPosition())
         {
-            if (position->getBpm() && position->getPpqPosition())
+            gotTransportInfo = true;
+            auto p = *(position->getPpqPosition());
+            auto b = *(position->getBpm());
+            bool resetPosition = false;
+
+            if ((!wasPlayingLastFrame && position->getIsPlaying()) || (p < lastPPQPosition))
             {
-                gotTransportInfo = true;
-                auto p = *(position->getPpqPosition());
-                auto b = *(position->getBpm());
-                bool resetPosition = false;
-
-                if ((!wasPlayingLastFrame && position->getIsPlaying()) || (p < lastPPQPosition))
-                {
-                    resetPosition = true;
-                }
-
-                wasPlayingLastFrame = position->getIsPlaying();
-                lastPPQPosition = p;
-                synth.setPlayHead(b, p, resetPosition);
+                resetPosition = true;
             }
+
+            wasPlayingLastFrame = position->getIsPlaying();
+            lastPPQPosition = p;
+            synth.setPlayHead(b, p, resetPosition);
         }
     }
 
@@ -170,6 +469,20 @@ void ObxfAudioProcessor::processBlock(juce::AudioBuffer<float> &buffer,
 
     synth.getMotherboard()->tuning.updateMTSESPStatus();
 
+    tailLengthSeconds.store(synth.getReleaseTailSeconds(), std::memory_order_relaxed);
+
+    // Nothing sounding and nothing coming in means the block is silence, so skip
+    // per-sample rendering and only keep the free-running engine state moving
+    const bool silent = !hasMidiMessage && !shadowActive && !synth.isSounding();
+
+    if (silent)
+    {
+        midiHandler.snapLags();
+        synth.processIdle(numSamples);
+        buffer.clear();
+        samplePos = numSamples;
+    }
+
     while (samplePos < numSamples)
     {
         if (hasMidiMessage)
@@ -181,6 +494,23 @@ void ObxfAudioProcessor::processBlock(juce::AudioBuffer<float> &buffer,
         midiHandler.processLags();
         synth.processSample(channelData1 + samplePos, channelData2 + samplePos);
 
+        if (shadowActive)
+        {
+            float shadowL{0.f}, shadowR{0.f};
+            shadowSynth->processSample(&shadowL, &shadowR);
+            if (channelData2 != channelData1)
+            {
+                channelData1[samplePos] += shadowL;
+            }
+            channelData2[samplePos] += shadowR;
+
+            if (!shadowSynth->isSounding())
+            {
+                shadowActive = false;
+                midiHandler.setShadowEngine(nullptr);
+            }
+        }
+
         ++samplePos;
     }
 
@@ -203,6 +533,13 @@ void ObxfAudioProcessor::processBlock(juce::AudioBuffer<float> &buffer,
             updateUIState();
         }
     }
+
+    const auto *mb = synth.getMotherboard();
+    dspLoad.endBlock(numSamples, getSampleRate(), mb->getSoundingVoiceCount(), mb->oversample);
+
+    clapDirectProcess.store(!synth.isHeld(), std::memory_order_relaxed);
+
+    return silent;
 }
 
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -249,7 +586,10 @@ bool ObxfAudioProcessor::producesMidi() const
 }
 
 bool ObxfAudioProcessor::isMidiEffect() const { return false; }
-double ObxfAudioProcessor::getTailLengthSeconds() const { return 0.0; }
+double ObxfAudioProcessor::getTailLengthSeconds() const
+{
+    return static_cast<double>(tailLengthSeconds.load(std::memory_order_relaxed));
+}
 
 int ObxfAudioProcessor::getNumPrograms()
 {
@@ -285,16 +625,24 @@ const juce::String ObxfAudioProcessor::getProgramName(const int index)
     return utils->patchesAsLinearList[index - 1]->displayName;
 }
 
-void ObxfAudioProcessor::applyActiveProgramValuesToJUCEParameters()
+void ObxfAudioProcessor::applyActiveProgramValuesToJUCEParameters(bool crossfade)
 {
     juce::ScopedValueSetter<bool> svs(isHostAutomatedChange, false);
     if (!paramCoordinator->getParameterUpdateHandler().isFIFOClear())
     {
         OBLOG(params, "Deferring applying for update");
-        juce::Timer::callAfterDelay(50, [this]() { applyActiveProgramValuesToJUCEParameters(); });
+        juce::Timer::callAfterDelay(
+            50, [this, crossfade]() { applyActiveProgramValuesToJUCEParameters(crossfade); });
         return;
     }
 
+    if (crossfade)
+    {
+        // ahead of the values in the same FIFO, so the audio thread moves the old voices
+        // over before it applies any of the new patch
+        paramCoordinator->getParameterUpdateHandler().queuePatchChange();
+    }
+
     paramCoordinator->getParameterUpdateHandler().setSuppressGestureToUndo(true);
 
     const Program &prog = activeProgram;
@@ -327,7 +675,7 @@ void ObxfAudioProcessor::applyActiveProgramValuesToJUCEParameters()
 
 void ObxfAudioProcessor::processActiveProgramChanged()
 {
-    applyActiveProgramValuesToJUCEParameters();
+    applyActiveProgramValuesToJUCEParameters(patchCrossfade.load());
     sendChangeMessageWithUndoSuppressed();
 }
 
@@ -371,16 +719,115 @@ void ObxfAudioProcessor::setEngineParameterValue(const juce::String &paramId, fl
 
 void ObxfAudioProcessor::handleMIDIProgramChange(const int programNumber)
 {
-    if (utils->firstMidiProgram > -1 && programNumber < utils->numMidiPrograms)
+    // This runs on the audio thread, so only ever pick up an already decoded program
+    if (const auto *prog = midiProgramBank.get(programNumber))
     {
-        utils->loadPatch(utils->patchesAsLinearList[utils->firstMidiProgram + programNumber]);
-        processActiveProgramChanged();
+        beginPatchCrossfade();
+        applyPreparedProgramToEngine(*prog);
+        midiProgramBank.markApplied(prog);
+    }
+}
+
+void ObxfAudioProcessor::prepareMidiProgramBank()
+{
+    // decoded once by the patch scan and shared with every other instance
+    midiProgramBank.publish(utils->midiPrograms);
+}
+
+bool ObxfAudioProcessor::isLockedParameterIndex(const int idx) const
+{
+    if (lockHighQuality.load() && idx == hqModeParamIndex)
+    {
+        return true;
+    }
+
+    if (lockPitchBend.load() && (idx == bendUpParamIndex || idx == bendDownParamIndex))
+    {
+        return true;
     }
+
+    return false;
+}
+
+void ObxfAudioProcessor::applyPreparedProgramToEngine(const PreparedProgram &prog)
+{
+    for (size_t i = 0; i < prog.values.size(); ++i)
+    {
+        if (!isLockedParameterIndex(static_cast<int>(i)))
+        {
+            paramCoordinator->applyEngineParameterByIndex(i, prog.values[i]);
+        }
+    }
+
+    synth.getMotherboard()->voiceMatrix.rows = prog.matrixRows;
+}
+
+void ObxfAudioProcessor::timerCallback() { takeAudioThreadHandover(); }
+
+void ObxfAudioProcessor::takeAudioThreadHandover()
+{
+    midiHandler.notifySettledLags();
+
+    const auto *prog = midiProgramBank.takeApplied();
+
+    if (!prog)
+    {
+        return;
+    }
+
+    // The engine already has these values; bring the program, parameters and host along
+    for (size_t i = 0; i < prog->values.size() && i < ParameterList.size(); ++i)
+    {
+        if (!isLockedParameterIndex(static_cast<int>(i)))
+        {
+            activeProgram.setValueById(ParameterList[i].ID, prog->values[i]);
+        }
+    }
+
+    activeProgram.setName(prog->name);
+    activeProgram.setAuthor(prog->author);
+    activeProgram.setLicense(prog->license);
+    activeProgram.setCategory(prog->category);
+    activeProgram.setProject(prog->project);
+
+    // The program may come from a bank older than the tree we have now, in which case its
+    // index points at whatever patch sits there after the rescan; report no patch instead
+    const auto idx = prog->patchIndex;
+    const bool listed = idx >= 0 && idx < static_cast<int>(utils->patchesAsLinearList.size()) &&
+                        idx >= utils->firstMidiProgram &&
+                        idx < utils->firstMidiProgram + utils->numMidiPrograms &&
+                        midiProgramBank.get(idx - utils->firstMidiProgram) == prog;
+
+    if (utils->hostUpdateCallback)
+    {
+        utils->hostUpdateCallback(listed ? idx : -1);
+    }
+
+    // not processActiveProgramChanged, since the audio thread already did the crossfade
+    applyActiveProgramValuesToJUCEParameters();
+    sendChangeMessageWithUndoSuppressed();
+}
+
+void ObxfAudioProcessor::beginPatchCrossfade()
+{
+    // While a previous crossfade is still ringing out, the shadow engine is taken; cloning
+    // over it would cut those tails off, so this change is applied as if crossfade were off
+    if (!patchCrossfade.load() || !synth.isSounding() || shadowActive)
+    {
+        return;
+    }
+
+    shadowSynth->cloneFrom(synth);
+    shadowActive = true;
+    midiHandler.setShadowEngine(shadowSynth.get());
+
+    synth.allSoundOff();
 }
 
 void ObxfAudioProcessor::getStateInformation(juce::MemoryBlock &destData)
 {
     midiHandler.snapLags();
+    midiHandler.notifySettledLags();
     state->collectDAWExtraStateFromInstance();
     state->getPluginStateInformation(destData);
 }
@@ -500,6 +947,8 @@ void ObxfAudioProcessor::initializeUtilsCallbacks()
         activeProgram.getName().copyToUTF8(buffer, maxSize);
     };
 
+    utils->patchTreeRescannedCallback = [this]() { prepareMidiProgramBank(); };
+
     utils->resetPatchToDefault = [this]() {
         activeProgram.setToDefaultPatch();
         // we send here since with other patch loads we send
@@ -510,6 +959,10 @@ void ObxfAudioProcessor::initializeUtilsCallbacks()
 
 void ObxfAudioProcessor::initializeCallbacks()
 {
+    paramCoordinator->getParameterUpdateHandler().onPatchChange = [this]() {
+        beginPatchCrossfade();
+    };
+
     initializeLockCallbacks();
     initializeMidiCallbacks();
     initializeUtilsCallbacks();
@@ -518,6 +971,8 @@ void ObxfAudioProcessor::initializeCallbacks()
 void ObxfAudioProcessor::mutatePatch()
 {
     paramAlgos->mutate(activeProgram, mutateSections);
+    // the library holds patches as they are on disk, so the locks go on afterwards
+    state->applyParameterLocks(activeProgram);
     processActiveProgramChanged();
     sendChangeMessage();
 }
@@ -542,6 +997,32 @@ void ObxfAudioProcessor::updateUIState()
     }
 }
 
+void ObxfAudioProcessor::setRenderSeed(uint32_t seed)
+{
+    // reseeding rewrites per voice state the audio thread reads
+    const juce::ScopedLock sl(getCallbackLock());
+
+    lockSeed.store(true);
+    synth.setSeed(seed);
+    shadowSynth->setSeed(seed);
+}
+
+void ObxfAudioProcessor::unlockRenderSeed()
+{
+    if (!lockSeed.load())
+    {
+        return;
+    }
+
+    const auto seed = static_cast<uint32_t>(juce::Random::getSystemRandom().nextInt());
+
+    const juce::ScopedLock sl(getCallbackLock());
+
+    lockSeed.store(false);
+    synth.setSeed(seed);
+    shadowSynth->setSeed(seed);
+}
+
 void ObxfAudioProcessor::setMpeEnabled(bool enabled)
 {
     midiHandler.mpeEnabled.store(enabled);
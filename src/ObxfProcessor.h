@@ -23,11 +23,14 @@
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_audio_utils/juce_audio_utils.h>
 #include <juce_dsp/juce_dsp.h>
+#include <clap-juce-extensions/clap-juce-extensions.h>
 #include <random>
+#include <unordered_map>
 
 #include "engine/SynthEngine.h"
 #include "engine/MidiMap.h"
 #include "Constants.h"
+#include "DspLoadMeter.h"
 #include "ParameterCoordinator.h"
 #include "ParameterAlgos.h"
 #include "MidiHandler.h"
@@ -37,8 +40,11 @@
 #include "configuration.h"
 
 class ObxfAudioProcessor final : public juce::AudioProcessor,
+                                 public clap_juce_extensions::clap_juce_audio_processor_capabilities,
                                  public IParameterState,
-                                 public IProgramState
+                                 public IProgramState,
+                                 private juce::AudioProcessorListener,
+                                 private juce::Timer
 {
   public:
     ObxfAudioProcessor();
@@ -66,6 +72,20 @@ class ObxfAudioProcessor final : public juce::AudioProcessor,
 
     double getTailLengthSeconds() const override;
 
+    /*
+     * Once no key is held the CLAP wrapper hands processing over to us, so we can tell the
+     * host to rely on the tail while voices release and to sleep when they are done.
+     * While a key is held the wrapper processes as usual, and so it does for a couple of
+     * blocks after any parameter change or gesture we didn't take from the host: only the
+     * wrapper's process call sends those on to the host's output events.
+     */
+    bool supportsDirectProcess() override
+    {
+        return clapDirectProcess.load(std::memory_order_relaxed) &&
+               clapWrapperBlocks.load(std::memory_order_acquire) == 0;
+    }
+    clap_process_status clap_direct_process(const clap_process *process) noexcept override;
+
     // This is the DAW program API
     int getNumPrograms() override;
     int getCurrentProgram() override;
@@ -94,7 +114,20 @@ class ObxfAudioProcessor final : public juce::AudioProcessor,
     void processActiveProgramChanged();
     void handleMIDIProgramChange(int programNumber);
 
+    // Picks up the MIDI programs the patch scan decoded, so program changes never touch the disk
+    void prepareMidiProgramBank();
+    PreparedProgramBank &getMidiProgramBank() { return midiProgramBank; }
+
+    /*
+     * Brings what the audio thread applied on its own (settled MIDI lags, MIDI program
+     * changes) into the program, the parameters and the host, since it can't post messages
+     * itself. A timer polls this on the message thread; without a message loop whoever
+     * drives processBlock calls it between blocks instead, see OfflineRenderer.
+     */
+    void takeAudioThreadHandover();
+
     MidiMap &getMidiMap() { return bindings; }
+    const MidiMap &getMidiMap() const { return bindings; }
 
     bool getMidiLearnParameterSelected() const override
     {
@@ -142,6 +175,9 @@ class ObxfAudioProcessor final : public juce::AudioProcessor,
 
     std::atomic<bool> dynamicMTSESP{false};
 
+    // When set, a patch change hands the sounding voices to a shadow engine to release there
+    std::atomic<bool> patchCrossfade{false};
+
     std::atomic<bool> lockPitchBend{false};
     std::atomic<bool> lockHighQuality{false};
 
@@ -150,7 +186,11 @@ class ObxfAudioProcessor final : public juce::AudioProcessor,
 
     bool lockedHQ{false};
 
-    void applyActiveProgramValuesToJUCEParameters();
+    // When set, the engine seed is kept in the session so renders repeat; see setRenderSeed
+    std::atomic<bool> lockSeed{false};
+
+    // With crossfade, the patch change is queued ahead of the values; see beginPatchCrossfade
+    void applyActiveProgramValuesToJUCEParameters(bool crossfade = false);
 
     struct ObxfParams
     {
@@ -219,8 +259,16 @@ class ObxfAudioProcessor final : public juce::AudioProcessor,
 
     SynthEngine &getSynth() { return synth; }
     const SynthEngine &getSynth() const { return synth; }
+    DspLoadMeter &getDspLoadMeter() { return dspLoad; }
+    const DspLoadMeter &getDspLoadMeter() const { return dspLoad; }
 
     void setMpeEnabled(bool enabled);
+
+    // Fixes every random source in the engine to the seed, and keeps it with the session
+    void setRenderSeed(uint32_t seed);
+    // Drops a seed set above, so the instance sounds a little different again
+    void unlockRenderSeed();
+    uint32_t getRenderSeed() const { return synth.getSeed(); }
     void setMpePitchBendRange(int range);
 
     void setGlobalPitchBendRange(int range);
@@ -242,6 +290,38 @@ class ObxfAudioProcessor final : public juce::AudioProcessor,
 
     bool isHostAutomatedChange{true};
     SynthEngine synth;
+    // allocated up front so starting a crossfade on the audio thread is just a copy
+    std::unique_ptr<SynthEngine> shadowSynth;
+    bool shadowActive{false};
+
+    void beginPatchCrossfade();
+
+    // refreshed every block so hosts can query it from any thread
+    std::atomic<float> tailLengthSeconds{0.f};
+
+    // set after every block that ends with no key held, see supportsDirectProcess
+    std::atomic<bool> clapDirectProcess{true};
+    // wrapper blocks still owed since the last outbound parameter change or gesture
+    static constexpr int clapOutboundDrainBlocks{2};
+    std::atomic<int> clapWrapperBlocks{0};
+    void requireClapWrapper();
+
+    void audioProcessorChanged(juce::AudioProcessor *, const ChangeDetails &) override {}
+    void audioProcessorParameterChanged(juce::AudioProcessor *, int, float) override;
+    void audioProcessorParameterChangeGestureBegin(juce::AudioProcessor *, int) override;
+    void audioProcessorParameterChangeGestureEnd(juce::AudioProcessor *, int) override;
+    // note and MIDI events of a direct CLAP block, sized in prepareToPlay
+    static constexpr size_t clapMidiBytes{8192};
+    juce::MidiBuffer clapMidi;
+    // the wrapper identifies parameters by the hash of their ID
+    std::unordered_map<clap_id, juce::AudioProcessorParameter *> clapParameters;
+
+    // Returns true when the block was silence and skipped rendering
+    bool renderBlock(juce::AudioBuffer<float> &buffer, juce::MidiBuffer &midiMessages,
+                     const juce::Optional<juce::AudioPlayHead::PositionInfo> &position);
+
+    DspLoadMeter dspLoad;
+
     MidiMap bindings;
 
     Program activeProgram;
@@ -252,6 +332,16 @@ class ObxfAudioProcessor final : public juce::AudioProcessor,
 
     std::unique_ptr<StateManager> state;
 
+    // program changes applied on the audio thread are handed over through markApplied
+    PreparedProgramBank midiProgramBank;
+    int hqModeParamIndex{-1}, bendUpParamIndex{-1}, bendDownParamIndex{-1};
+
+    void applyPreparedProgramToEngine(const PreparedProgram &prog);
+    bool isLockedParameterIndex(int idx) const;
+    // how often the message thread polls takeAudioThreadHandover
+    static constexpr int handoverPollHz{30};
+    void timerCallback() override;
+
     bool wasPlayingLastFrame{false};
     double lastPPQPosition{-1};
     double syntheticPPQPosition{-1};
@@ -22,6 +22,7 @@
 #include "sst/plugininfra/paths.h"
 #include "sst/plugininfra/strnatcmp.h"
 #include "Utils.h"
+#include "SharedPatchTree.h"
 
 namespace
 {
@@ -95,7 +96,31 @@ Utils::Utils() : configLock("__" JucePlugin_Name "ConfigLock__")
 
     // std::cout << "[Utils::Utils] Current theme: " << currentTheme.toStdString() << std::endl;
     scanAndUpdateThemes();
-    rescanPatchTree();
+
+    // Another instance may already hold the tree for these folders; otherwise show
+    // whatever the index remembers right away, then check the disk behind it
+    bool createdPatchTree{false};
+    sharedPatchTree =
+        SharedPatchTree::acquire(getPatchRoots(), getDocumentFolder(), createdPatchTree);
+    patchTreeListener = sharedPatchTree->addListener(
+        [this](const SharedPatchTree::tree_t &tree) { publishPatchTree(*tree); });
+
+    if (const auto tree = sharedPatchTree->current())
+    {
+        publishPatchTree(*tree);
+    }
+    else
+    {
+        patchRoot = std::make_shared<PatchTreeNode>();
+        patchRoot->isFolder = true;
+        patchRoot->displayName = "root";
+        patchRoot->locationType = LocationType::EMBEDDED;
+    }
+
+    if (createdPatchTree)
+    {
+        sharedPatchTree->rescanInBackground();
+    }
 
     if (themeLocations.size() > 0 && !currentTheme.file.exists() &&
         currentTheme.locationType != EMBEDDED)
@@ -107,6 +132,8 @@ Utils::Utils() : configLock("__" JucePlugin_Name "ConfigLock__")
 
 Utils::~Utils()
 {
+    sharedPatchTree->removeListener(patchTreeListener);
+
     if (config)
         config->saveIfNeeded();
     config = nullptr;
@@ -319,7 +346,12 @@ bool Utils::loadPatch(const juce::File &fxpFile, Program &program)
     return false;
 }
 
-bool Utils::serializeProgramToMemoryBlock(const Program &program, juce::MemoryBlock &out) const
+std::shared_ptr<const PatchLibrary::values_t> Utils::getDecodedPatch(const juce::File &fxpFile)
+{
+    return sharedPatchTree->getDecodedPatch(fxpFile);
+}
+
+bool Utils::serializeProgramToMemoryBlock(const Program &program, juce::MemoryBlock &out)
 {
     // Build the OB-Xf program XML directly from the supplied Program, mirroring
     // the schema written by StateManager::getProgramStateInformation but without
@@ -629,33 +661,59 @@ juce::File Utils::getPatchFolderFor(LocationType loc) const
     return getDocumentFolder().getChildFile("Patches");
 }
 
-void Utils::rescanPatchTree()
+Utils::PatchRoots Utils::getPatchRoots() const
 {
-    patchesAsLinearList.clear();
-    lastFactoryPatch = 0;
-    firstMidiProgram = -1;
-    numMidiPrograms = -1;
-
-    patchRoot = std::make_shared<PatchTreeNode>();
-    patchRoot->isFolder = true;
-    patchRoot->children.clear();
-    patchRoot->displayName = "root";
-    patchRoot->locationType = LocationType::EMBEDDED;
+    PatchRoots res;
 
     for (auto &f : {SYSTEM_FACTORY, LOCAL_FACTORY, USER})
     {
-        auto fl = getPatchFolderFor(f);
+        res.emplace_back(f, getPatchFolderFor(f));
+    }
+
+    return res;
+}
+
+std::vector<int> Utils::searchPatches(const juce::String &query, int fieldMask, bool prefixOnly,
+                                      size_t maxResults) const
+{
+    if (!patchMetadata)
+    {
+        return {};
+    }
+
+    return patchMetadata->search(query, fieldMask, prefixOnly, maxResults);
+}
+
+void Utils::rescanPatchTree() { sharedPatchTree->rescan(); }
+
+Utils::PatchTree Utils::buildPatchTree(const PatchRoots &roots, PatchFolderIndex &index,
+                                       bool trustIndex)
+{
+    PatchTree tree;
+
+    tree.root = std::make_shared<PatchTreeNode>();
+    tree.root->isFolder = true;
+    tree.root->children.clear();
+    tree.root->displayName = "root";
+    tree.root->locationType = LocationType::EMBEDDED;
+
+    index.beginScan();
+
+    for (const auto &[f, fl] : roots)
+    {
         if (fl.isDirectory())
         {
             PatchTreeNode::ptr_t pt = std::make_shared<PatchTreeNode>();
             pt->isFolder = true;
             pt->locationType = f;
             pt->displayName = "Root";
-            scanPatchFolderInto(pt, f, fl);
-            patchRoot->children.push_back(std::move(pt));
+            scanPatchFolderInto(pt, f, fl, index, trustIndex);
+            tree.root->children.push_back(std::move(pt));
         }
     }
 
+    index.endScan();
+
     auto applyRec = [](PatchTreeNode::ptr_t node,
                        const std::function<bool(const PatchTreeNode::ptr_t &)> &f,
                        auto &&self) -> void {
@@ -671,14 +729,14 @@ void Utils::rescanPatchTree()
     int idx{0};
     // First index every root note
     applyRec(
-        patchRoot,
-        [this, &idx](auto node) -> bool {
+        tree.root,
+        [&tree, &idx](auto node) -> bool {
             if (!node->isFolder)
             {
                 node->index = idx++;
                 if (node->locationType == LocationType::SYSTEM_FACTORY ||
                     node->locationType == LocationType::LOCAL_FACTORY)
-                    lastFactoryPatch = idx;
+                    tree.lastFactoryPatch = idx;
                 return true;
             }
             return false;
@@ -709,7 +767,7 @@ void Utils::rescanPatchTree()
             node->childRange = {start, end};
         }
     };
-    childRange(patchRoot, childRange);
+    childRange(tree.root, childRange);
 
     auto idxInParent = [](const PatchTreeNode::ptr_t node, auto &&self) -> void {
         int idx{0};
@@ -725,20 +783,20 @@ void Utils::rescanPatchTree()
             }
         }
     };
-    idxInParent(patchRoot, idxInParent);
+    idxInParent(tree.root, idxInParent);
 
     int midiFolderIdx{0}; // so that we know where the first patch in MIDI Programs folder is
 
     // Finally collect just the root nodes into a linear list copy
     applyRec(
-        patchRoot,
-        [this, &midiFolderIdx](auto node) -> bool {
+        tree.root,
+        [&tree, &midiFolderIdx](auto node) -> bool {
             if (node->isFolder)
             {
                 if (midiFolderIdx == 0 && node->locationType == LocationType::USER &&
                     node->displayName.compare("MIDI Programs") == 0)
                 {
-                    numMidiPrograms = node->childRange.second - node->childRange.first + 1;
+                    tree.numMidiPrograms = node->childRange.second - node->childRange.first + 1;
                     midiFolderIdx = 1;
                 }
             }
@@ -746,11 +804,11 @@ void Utils::rescanPatchTree()
             {
                 if (midiFolderIdx == 1)
                 {
-                    firstMidiProgram = node->index;
+                    tree.firstMidiProgram = node->index;
                     midiFolderIdx = -1;
                 }
 
-                patchesAsLinearList.push_back(node);
+                tree.linearList.push_back(node);
 
                 return true;
             }
@@ -759,15 +817,40 @@ void Utils::rescanPatchTree()
         },
         applyRec);
 
+    return tree;
+}
+
+void Utils::publishPatchTree(const PatchTree &tree)
+{
+    // the nodes themselves are shared with the other instances and never change
+    patchRoot = tree.root;
+    patchesAsLinearList = tree.linearList;
+    lastFactoryPatch = tree.lastFactoryPatch;
+    firstMidiProgram = tree.firstMidiProgram;
+    numMidiPrograms = tree.numMidiPrograms;
+    patchMetadata = tree.metadata;
+    midiPrograms = tree.midiPrograms;
+
     patchRoot->print();
+
+    if (patchTreeRescannedCallback)
+    {
+        patchTreeRescannedCallback();
+    }
 }
 
 void Utils::scanPatchFolderInto(const PatchTreeNode::ptr_t &parent, LocationType lt,
-                                juce::File &folder)
+                                const juce::File &folder, PatchFolderIndex &index,
+                                bool trustIndex)
 {
-    for (auto &kid : folder.findChildFiles(juce::File::findFilesAndDirectories, false))
+    // copy, since recursing may grow the index
+    const auto entries = index.listFolder(folder, trustIndex).entries;
+
+    for (const auto &entry : entries)
     {
-        if (kid.isDirectory())
+        const auto kid = folder.getChildFile(entry.name);
+
+        if (entry.isFolder)
         {
             PatchTreeNode::ptr_t pt = std::make_shared<PatchTreeNode>();
             pt->parent = parent;
@@ -775,9 +858,9 @@ void Utils::scanPatchFolderInto(const PatchTreeNode::ptr_t &parent, LocationType
             pt->displayName = kid.getFileName();
             pt->isFolder = true;
             parent->children.push_back(std::move(pt));
-            scanPatchFolderInto(parent->children.back(), lt, kid);
+            scanPatchFolderInto(parent->children.back(), lt, kid, index, trustIndex);
         }
-        if (kid.getFileExtension().toLowerCase() == ".fxp")
+        else
         {
             PatchTreeNode::ptr_t pt = std::make_shared<PatchTreeNode>();
             pt->parent = parent;
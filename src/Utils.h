@@ -26,6 +26,12 @@
 
 #include "Program.h"
 #include "Constants.h"
+#include "PatchMetadataIndex.h"
+#include "PatchLibrary.h"
+
+class PatchFolderIndex;
+class SharedPatchTree;
+struct PreparedProgram;
 
 inline static float getPitch(float index) { return 440.f * std::exp(mult * index); };
 
@@ -197,9 +203,43 @@ class Utils final
         return getPatchFolderFor(LocationType::USER);
     }
     [[nodiscard]] const PatchTreeNode &getPatchRoot() const;
+
+    struct PatchTree
+    {
+        PatchTreeNode::ptr_t root;
+        std::vector<PatchTreeNode::ptr_t> linearList;
+        int32_t lastFactoryPatch{0};
+        int32_t firstMidiProgram{-1};
+        int32_t numMidiPrograms{-1};
+        std::shared_ptr<const PatchMetadataIndex::Table> metadata;
+        // the "MIDI Programs" patches, decoded by the scan, nullptr until it has run
+        std::shared_ptr<const std::vector<PreparedProgram>> midiPrograms;
+    };
+
+    // The folders a patch tree is built from, in the order they are listed
+    using PatchRoots = std::vector<std::pair<LocationType, juce::File>>;
+    [[nodiscard]] PatchRoots getPatchRoots() const;
+
+    // Rescans right away, re-enumerating only the folders which changed. The tree is
+    // shared by every instance using the same folders, so all of them pick it up
     void rescanPatchTree();
-    void scanPatchFolderInto(const PatchTreeNode::ptr_t &parent, LocationType lt,
-                             juce::File &folder);
+    [[nodiscard]] static PatchTree buildPatchTree(const PatchRoots &roots, PatchFolderIndex &index,
+                                                  bool trustIndex);
+    void publishPatchTree(const PatchTree &tree);
+    static void scanPatchFolderInto(const PatchTreeNode::ptr_t &parent, LocationType lt,
+                                    const juce::File &folder, PatchFolderIndex &index,
+                                    bool trustIndex);
+
+    // Metadata of every patch, row n belongs to patchesAsLinearList[n]
+    std::shared_ptr<const PatchMetadataIndex::Table> patchMetadata;
+    // Program n belongs to patchesAsLinearList[firstMidiProgram + n], shared between instances
+    std::shared_ptr<const std::vector<PreparedProgram>> midiPrograms;
+
+    // Indices into patchesAsLinearList of patches matching the query, see
+    // PatchMetadataIndex::Table::search
+    std::vector<int> searchPatches(const juce::String &query,
+                                   int fieldMask = PatchMetadataIndex::allFields,
+                                   bool prefixOnly = false, size_t maxResults = 0) const;
 
     // MIDI management
     struct MidiLocation
@@ -252,12 +292,15 @@ class Utils final
     bool loadPatch(const PatchTreeNode::ptr_t &fxpFile);
     bool loadPatch(const juce::File &fxpFile);
     bool loadPatch(const juce::File &fxpFile, Program &program);
+    // Values of a patch file in ParameterList order, decoded by the patch scan and kept in
+    // memory; nullptr until the scan has got to it. Parameter locks are not applied
+    std::shared_ptr<const PatchLibrary::values_t> getDecodedPatch(const juce::File &fxpFile);
     bool savePatch(const juce::File &fxpFile);
     void initializePatch() const;
 
     // Serialize an arbitrary Program (not necessarily the active one) into a MemoryBlock
     // Used by the OB-Xd importer to write individual patches
-    bool serializeProgramToMemoryBlock(const Program &program, juce::MemoryBlock &out) const;
+    static bool serializeProgramToMemoryBlock(const Program &program, juce::MemoryBlock &out);
 
     // copy paste and detect a serialized FXP onto clipboard
     void copyPatch();
@@ -271,6 +314,7 @@ class Utils final
     std::function<void(juce::MemoryBlock &)> getProgramStateInformation;
     std::function<void(char *, int)> copyTruncatedProgramNameToFXPBuffer;
     std::function<void()> resetPatchToDefault;
+    std::function<void()> patchTreeRescannedCallback;
 
     juce::File fsPathToJuceFile(const fs::path &) const;
     fs::path juceFileToFsPath(const juce::File &) const;
@@ -310,6 +354,10 @@ class Utils final
     // patch
     juce::String currentPatch;
     juce::File currentPatchFile;
+
+    // patch tree, shared with every other instance, see SharedPatchTree
+    std::shared_ptr<SharedPatchTree> sharedPatchTree;
+    int patchTreeListener{-1};
 };
 
 #endif // OBXF_SRC_UTILS_H
@@ -0,0 +1,211 @@
+/*
+ * OB-Xd was originally written by Vadim Filatov, and then a version
+ * was released under the GPL3 at https://github.com/reales/OB-Xd.
+ * Subsequently, the product was continued by DiscoDSP and the copyright
+ * holders as an excellent closed source product.
+ *
+ * This repository is a successor to OB-Xd version 2.11.
+ * Copyright 2013-2025 by the authors as indicated in the original release,
+ * and subsequent authors as per GitHub transaction log.
+ *
+ * OB-Xf is released under the GNU General Public Licence v3 or later
+ * (GPL-3.0-or-later). The license is found in the file "LICENSE"
+ * in the root of this repository or at:
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * Source code is available at https://github.com/surge-synthesizer/OB-Xf
+ */
+
+#include <algorithm>
+#include <iostream>
+
+#include <juce_core/juce_core.h>
+
+#include "DatasetGenerator.h"
+
+/*
+ * Renders a patch × pitch × velocity dataset without a host:
+ *
+ *   obxf-dataset [options] <output folder> <patch.fxp or folder of patches>...
+ *
+ * Folders are searched recursively for .fxp files. Running it again on the same folder
+ * with the same options renders only the shards which are not there yet. See
+ * DatasetGenerator for the layout of the output folder.
+ */
+namespace
+{
+void usage()
+{
+    std::cerr
+        << "usage: obxf-dataset [options] <output folder> <patch.fxp|folder>...\n"
+           "  -n, --notes LOW:HIGH[:STEP]  note range (default 36:84)\n"
+           "  -v, --velocities V,V,...     velocity layers (default 127)\n"
+           "  -l, --length SECONDS         time each note is held (default 1)\n"
+           "  -t, --tail SECONDS           time rendered after the release (default 1)\n"
+           "  -r, --rate HZ                sample rate (default 48000)\n"
+           "  -s, --shard-size N           items per shard (default 128)\n"
+           "  -f, --format FORMAT          npy or wav (default npy)\n"
+           "  -j, --jobs N                 render threads (default: one per core)\n"
+           "      --seed N                 engine seed (default 0)"
+        << std::endl;
+}
+
+bool parseOptions(juce::StringArray &args, DatasetGenerator::Spec &spec, int &numWorkers)
+{
+    while (!args.isEmpty() && args[0].startsWith("-"))
+    {
+        const auto opt = args[0];
+
+        if (args.size() < 2)
+        {
+            return false;
+        }
+
+        const auto value = args[1];
+        args.removeRange(0, 2);
+
+        if (opt == "-n" || opt == "--notes")
+        {
+            juce::StringArray parts;
+            parts.addTokens(value, ":", "");
+
+            if (parts.size() < 2 || parts.size() > 3)
+            {
+                return false;
+            }
+
+            spec.lowestNote = parts[0].getIntValue();
+            spec.highestNote = parts[1].getIntValue();
+            spec.noteStep = parts.size() == 3 ? parts[2].getIntValue() : 1;
+        }
+        else if (opt == "-v" || opt == "--velocities")
+        {
+            juce::StringArray parts;
+            parts.addTokens(value, ",", "");
+
+            spec.velocities.clear();
+
+            for (const auto &p : parts)
+            {
+                spec.velocities.push_back(p.getIntValue());
+            }
+        }
+        else if (opt == "-l" || opt == "--length")
+        {
+            spec.noteSeconds = value.getDoubleValue();
+        }
+        else if (opt == "-t" || opt == "--tail")
+        {
+            spec.tailSeconds = value.getDoubleValue();
+        }
+        else if (opt == "-r" || opt == "--rate")
+        {
+            spec.sampleRate = value.getDoubleValue();
+        }
+        else if (opt == "-s" || opt == "--shard-size")
+        {
+            spec.shardSize = value.getIntValue();
+        }
+        else if (opt == "-f" || opt == "--format")
+        {
+            if (value != "npy" && value != "wav")
+            {
+                return false;
+            }
+
+            spec.format = value == "wav" ? DatasetGenerator::Wav : DatasetGenerator::Npy;
+        }
+        else if (opt == "-j" || opt == "--jobs")
+        {
+            numWorkers = value.getIntValue();
+        }
+        else if (opt == "--seed")
+        {
+            spec.seed = static_cast<uint32_t>(value.getLargeIntValue());
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    return args.size() >= 2;
+}
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    juce::StringArray args;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        args.add(juce::String::fromUTF8(argv[i]));
+    }
+
+    DatasetGenerator::Spec spec;
+    int numWorkers{0};
+
+    if (!parseOptions(args, spec, numWorkers))
+    {
+        usage();
+        return 2;
+    }
+
+    const auto cwd = juce::File::getCurrentWorkingDirectory();
+    const auto outputFolder = cwd.getChildFile(args[0]);
+
+    for (int i = 1; i < args.size(); ++i)
+    {
+        const auto f = cwd.getChildFile(args[i]);
+
+        if (f.isDirectory())
+        {
+            auto found = f.findChildFiles(juce::File::findFiles, true, "*.fxp");
+
+            // the item numbering has to be the same from run to run
+            std::sort(found.begin(), found.end(), [](const auto &a, const auto &b) {
+                return a.getFullPathName() < b.getFullPathName();
+            });
+
+            for (const auto &kid : found)
+            {
+                spec.patches.push_back(kid);
+            }
+        }
+        else if (f.existsAsFile())
+        {
+            spec.patches.push_back(f);
+        }
+        else
+        {
+            std::cerr << "not found: " << f.getFullPathName() << std::endl;
+        }
+    }
+
+    std::cout << spec.numItems() << " items from " << spec.patches.size() << " patches"
+              << std::endl;
+
+    DatasetGenerator generator(spec, outputFolder);
+
+    const auto res = generator.run(numWorkers, [](int done, int total) {
+        std::cout << "shard " << done << " of " << total << std::endl;
+    });
+
+    if (!res.error.empty())
+    {
+        std::cerr << res.error << std::endl;
+        return 1;
+    }
+
+    std::cout << "rendered " << res.renderedShards << " shards, " << res.skippedShards
+              << " already done";
+
+    if (res.failedItems > 0)
+    {
+        std::cout << ", " << res.failedItems << " items failed (see manifest.jsonl)";
+    }
+
+    std::cout << std::endl;
+
+    return res.failedItems > 0 ? 1 : 0;
+}
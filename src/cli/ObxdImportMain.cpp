@@ -0,0 +1,108 @@
+/*
+ * OB-Xd was originally written by Vadim Filatov, and then a version
+ * was released under the GPL3 at https://github.com/reales/OB-Xd.
+ * Subsequently, the product was continued by DiscoDSP and the copyright
+ * holders as an excellent closed source product.
+ *
+ * This repository is a successor to OB-Xd version 2.11.
+ * Copyright 2013-2025 by the authors as indicated in the original release,
+ * and subsequent authors as per GitHub transaction log.
+ *
+ * OB-Xf is released under the GNU General Public Licence v3 or later
+ * (GPL-3.0-or-later). The license is found in the file "LICENSE"
+ * in the root of this repository or at:
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * Source code is available at https://github.com/surge-synthesizer/OB-Xf
+ */
+
+#include <iostream>
+
+#include <juce_core/juce_core.h>
+
+#include "ObxdImporter.h"
+#include "Utils.h"
+
+/*
+ * Bulk converts OB-Xd banks into OB-Xf patches without a host:
+ *
+ *   obxf-import [--jobs N] <destination folder> <bank.fxb or folder of banks>...
+ *
+ * Folders are searched recursively for .fxb files. Each bank ends up in a subfolder of
+ * the destination named after the bank file, as with importing from the patch menu.
+ */
+int main(int argc, char *argv[])
+{
+    juce::StringArray args;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        args.add(juce::String::fromUTF8(argv[i]));
+    }
+
+    ObxdImporter::BankImportOptions options;
+
+    if (args.size() >= 2 && (args[0] == "--jobs" || args[0] == "-j"))
+    {
+        options.numWorkers = args[1].getIntValue();
+        args.removeRange(0, 2);
+    }
+
+    if (args.size() < 2)
+    {
+        std::cerr << "usage: obxf-import [--jobs N] <destination folder> <bank.fxb|folder>..."
+                  << std::endl;
+        return 2;
+    }
+
+    const auto cwd = juce::File::getCurrentWorkingDirectory();
+    const auto destFolder = cwd.getChildFile(args[0]);
+    std::vector<juce::File> banks;
+
+    for (int i = 1; i < args.size(); ++i)
+    {
+        const auto f = cwd.getChildFile(args[i]);
+
+        if (f.isDirectory())
+        {
+            for (const auto &kid : f.findChildFiles(juce::File::findFiles, true, "*.fxb"))
+            {
+                banks.push_back(kid);
+            }
+        }
+        else if (f.existsAsFile())
+        {
+            banks.push_back(f);
+        }
+        else
+        {
+            std::cerr << "not found: " << f.getFullPathName() << std::endl;
+        }
+    }
+
+    if (banks.empty() || !destFolder.createDirectory())
+    {
+        std::cerr << "nothing to import" << std::endl;
+        return 1;
+    }
+
+    options.progress = [](const ObxdImporter::BankImportProgress &p) {
+        std::cout << "\r" << p.banksRead << "/" << p.banksTotal << " banks, " << p.patchesWritten
+                  << " patches" << std::flush;
+    };
+
+    const auto result = ObxdImporter::importBanks(banks, destFolder,
+                                                  &Utils::serializeProgramToMemoryBlock, options);
+
+    std::cout << "\rimported " << result.imported << " patches from " << banks.size()
+              << " banks, skipped " << result.skipped << " init patches";
+
+    if (result.failedBanks > 0)
+    {
+        std::cout << ", " << result.failedBanks << " banks could not be read";
+    }
+
+    std::cout << std::endl;
+
+    return result.failedBanks > 0 ? 1 : 0;
+}
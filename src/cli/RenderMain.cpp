@@ -0,0 +1,499 @@
+/*
+ * OB-Xd was originally written by Vadim Filatov, and then a version
+ * was released under the GPL3 at https://github.com/reales/OB-Xd.
+ * Subsequently, the product was continued by DiscoDSP and the copyright
+ * holders as an excellent closed source product.
+ *
+ * This repository is a successor to OB-Xd version 2.11.
+ * Copyright 2013-2025 by the authors as indicated in the original release,
+ * and subsequent authors as per GitHub transaction log.
+ *
+ * OB-Xf is released under the GNU General Public Licence v3 or later
+ * (GPL-3.0-or-later). The license is found in the file "LICENSE"
+ * in the root of this repository or at:
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * Source code is available at https://github.com/surge-synthesizer/OB-Xf
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+
+#include <juce_audio_formats/juce_audio_formats.h>
+
+#include "ObxfProcessor.h"
+#include "OfflineRenderer.h"
+#include "ParameterList.h"
+#include "RenderCache.h"
+#include "RenderPool.h"
+
+/*
+ * Renders Standard MIDI Files through a patch without a host:
+ *
+ *   obxf-render [options] <patch.fxp or state file> <song.mid or folder of songs>...
+ *
+ * Folders are searched recursively for .mid and .midi files. Songs are rendered in
+ * parallel, one engine per job, each from silence. With -o DIR each song keeps its path
+ * below the folder it was found in. See usage() for the options.
+ */
+namespace
+{
+struct Options
+{
+    double sampleRate{48000.0};
+    int quality{-1}; // -1 keeps the patch's HQ mode
+    double tailSeconds{-1.0}; // -1 uses the patch's release time
+    int bits{24};
+    bool flac{false};
+    bool formatGiven{false};
+    int numWorkers{0};
+    uint32_t seed{0};
+    juce::File output;
+    juce::File cache;
+    int64_t cacheMegabytes{1024};
+};
+
+void usage()
+{
+    std::cerr
+        << "usage: obxf-render [options] <patch.fxp|state> <song.mid|folder>...\n"
+           "  -o, --output PATH     output file for a single song, else output folder\n"
+           "                        which mirrors the song folders (default: next to\n"
+           "                        each song)\n"
+           "  -r, --rate HZ         sample rate (default 48000)\n"
+           "  -q, --quality TIER    normal or high (default: as the patch has it)\n"
+           "  -t, --tail SECONDS    time to ring out after the last event\n"
+           "                        (default: the patch's release time)\n"
+           "  -b, --bits N          16, 24 or 32 (32 is float, WAV only; default 24)\n"
+           "  -f, --format FORMAT   wav or flac (default: from the output name, else wav)\n"
+           "  -j, --jobs N          songs rendered at once (default: one per core)\n"
+           "  -s, --seed N          engine seed; the same seed renders the same audio (default 0)\n"
+           "  -c, --cache DIR       reuse renders of songs that were rendered before\n"
+           "      --cache-size MB   drop the oldest renders beyond this (default 1024)"
+        << std::endl;
+}
+
+/*
+ * Notes, controllers, bends and pressure from every track, timed in samples. A song plays
+ * the one patch it is rendered with, so program changes are left out and only counted.
+ */
+bool readMidiFile(const juce::File &f, double sampleRate, std::vector<RenderEvent> &events,
+                  int64_t &length, int &programChanges)
+{
+    juce::FileInputStream in(f);
+    juce::MidiFile midiFile;
+
+    if (!in.openedOk() || !midiFile.readFrom(in))
+    {
+        return false;
+    }
+
+    midiFile.convertTimestampTicksToSeconds();
+
+    events.clear();
+    length = 0;
+    programChanges = 0;
+
+    for (int t = 0; t < midiFile.getNumTracks(); ++t)
+    {
+        for (const auto *meh : *midiFile.getTrack(t))
+        {
+            const auto time = std::llround(meh->message.getTimeStamp() * sampleRate);
+            RenderEvent e;
+
+            if (!OfflineRenderer::eventFromMidi(meh->message, time, e))
+            {
+                continue;
+            }
+
+            if (e.type == RenderEvent::ProgramChange)
+            {
+                ++programChanges;
+            }
+            else
+            {
+                events.push_back(e);
+                length = std::max(length, time + 1);
+            }
+        }
+    }
+
+    return true;
+}
+
+// The length without the trailing silence, but never shorter than minLength
+int trimmedLength(const float *left, const float *right, int numSamples, int minLength)
+{
+    static constexpr float silence{1.0e-5f};
+
+    auto n = numSamples;
+
+    while (n > minLength && std::abs(left[n - 1]) < silence && std::abs(right[n - 1]) < silence)
+    {
+        --n;
+    }
+
+    return n;
+}
+
+bool writeAudioFile(const juce::File &f, const float *left, const float *right, int numSamples,
+                    const Options &options)
+{
+    std::unique_ptr<juce::AudioFormat> format;
+
+    if (options.flac)
+    {
+        format = std::make_unique<juce::FlacAudioFormat>();
+    }
+    else
+    {
+        format = std::make_unique<juce::WavAudioFormat>();
+    }
+
+    f.deleteFile();
+    auto stream = f.createOutputStream();
+
+    if (!stream)
+    {
+        return false;
+    }
+
+    std::unique_ptr<juce::AudioFormatWriter> writer(format->createWriterFor(
+        stream.get(), options.sampleRate, 2, options.bits, {}, 0));
+
+    if (!writer)
+    {
+        return false;
+    }
+
+    // the writer owns the stream now
+    stream.release();
+
+    const float *channels[2] = {left, right};
+
+    return writer->writeFromFloatArrays(channels, 2, numSamples);
+}
+
+bool parseOptions(juce::StringArray &args, Options &options)
+{
+    const auto cwd = juce::File::getCurrentWorkingDirectory();
+
+    while (!args.isEmpty() && args[0].startsWith("-"))
+    {
+        const auto opt = args[0];
+
+        if (args.size() < 2)
+        {
+            return false;
+        }
+
+        const auto value = args[1];
+        args.removeRange(0, 2);
+
+        if (opt == "-o" || opt == "--output")
+        {
+            options.output = cwd.getChildFile(value);
+
+            if (!options.formatGiven)
+            {
+                options.flac = options.output.hasFileExtension("flac");
+            }
+        }
+        else if (opt == "-r" || opt == "--rate")
+        {
+            options.sampleRate = value.getDoubleValue();
+        }
+        else if (opt == "-q" || opt == "--quality")
+        {
+            if (value != "normal" && value != "high")
+            {
+                return false;
+            }
+
+            options.quality = value == "high" ? 1 : 0;
+        }
+        else if (opt == "-t" || opt == "--tail")
+        {
+            options.tailSeconds = std::max(0.0, value.getDoubleValue());
+        }
+        else if (opt == "-b" || opt == "--bits")
+        {
+            options.bits = value.getIntValue();
+        }
+        else if (opt == "-f" || opt == "--format")
+        {
+            if (value != "wav" && value != "flac")
+            {
+                return false;
+            }
+
+            options.flac = value == "flac";
+            options.formatGiven = true;
+        }
+        else if (opt == "-j" || opt == "--jobs")
+        {
+            options.numWorkers = value.getIntValue();
+        }
+        else if (opt == "-s" || opt == "--seed")
+        {
+            options.seed = static_cast<uint32_t>(value.getLargeIntValue());
+        }
+        else if (opt == "-c" || opt == "--cache")
+        {
+            options.cache = cwd.getChildFile(value);
+        }
+        else if (opt == "--cache-size")
+        {
+            options.cacheMegabytes = std::max<int64_t>(0, value.getLargeIntValue());
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    const auto bitsOk =
+        options.bits == 16 || options.bits == 24 || (options.bits == 32 && !options.flac);
+
+    return bitsOk && options.sampleRate >= 8000.0 && args.size() >= 2;
+}
+
+// The patch's release time, from an engine of its own
+double releaseTailSeconds(const juce::File &patch, double sampleRate)
+{
+    ObxfAudioProcessor processor;
+    OfflineRenderer renderer(processor);
+    juce::MemoryBlock mb;
+
+    renderer.prepare(sampleRate);
+
+    if (!patch.loadFileAsData(mb) || !renderer.loadPatch(mb))
+    {
+        return -1.0;
+    }
+
+    return processor.getSynth().getReleaseTailSeconds();
+}
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    juce::StringArray args;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        args.add(juce::String::fromUTF8(argv[i]));
+    }
+
+    Options options;
+
+    if (!parseOptions(args, options))
+    {
+        usage();
+        return 2;
+    }
+
+    const auto cwd = juce::File::getCurrentWorkingDirectory();
+    const auto patch = cwd.getChildFile(args[0]);
+    std::vector<juce::File> songs;
+    // where each song goes under -o DIR: its path below the folder it was found in
+    std::vector<juce::String> songPaths;
+
+    for (int i = 1; i < args.size(); ++i)
+    {
+        const auto f = cwd.getChildFile(args[i]);
+
+        if (f.isDirectory())
+        {
+            for (const auto &kid : f.findChildFiles(juce::File::findFiles, true, "*.mid;*.midi"))
+            {
+                songs.push_back(kid);
+                songPaths.push_back(kid.getRelativePathFrom(f));
+            }
+        }
+        else if (f.existsAsFile())
+        {
+            songs.push_back(f);
+            songPaths.push_back(f.getFileName());
+        }
+        else
+        {
+            std::cerr << "not found: " << f.getFullPathName() << std::endl;
+        }
+    }
+
+    if (songs.empty())
+    {
+        std::cerr << "nothing to render" << std::endl;
+        return 1;
+    }
+
+    const auto patchTail = releaseTailSeconds(patch, options.sampleRate);
+
+    if (patchTail < 0.0)
+    {
+        std::cerr << "could not load patch: " << patch.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    // a little past the release, then the silence is trimmed off again
+    const auto tail = options.tailSeconds >= 0.0 ? options.tailSeconds : patchTail + 0.25;
+    const auto tailSamples = static_cast<int64_t>(std::ceil(tail * options.sampleRate));
+
+    const bool singleOutputFile = songs.size() == 1 && options.output != juce::File() &&
+                                  !options.output.isDirectory() &&
+                                  options.output.getFileExtension().isNotEmpty();
+
+    if (!singleOutputFile && options.output != juce::File() && !options.output.createDirectory())
+    {
+        std::cerr << "could not create " << options.output.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    const juce::String ext = options.flac ? ".flac" : ".wav";
+    std::vector<juce::File> destinations;
+    std::map<juce::String, size_t> claimed;
+
+    for (size_t s = 0; s < songs.size(); ++s)
+    {
+        auto dest = songs[s].withFileExtension(ext);
+
+        if (singleOutputFile)
+        {
+            dest = options.output;
+        }
+        else if (options.output != juce::File())
+        {
+            dest = options.output.getChildFile(songPaths[s]).withFileExtension(ext);
+        }
+
+        // say, song.mid next to song.midi, or two folders holding the same names
+        const auto [it, added] =
+            claimed.emplace(dest.getFullPathName().toLowerCase(), destinations.size());
+
+        if (!added)
+        {
+            std::cerr << songs[it->second].getFullPathName() << " and "
+                      << songs[s].getFullPathName() << " would both render to "
+                      << dest.getFullPathName() << std::endl;
+            return 1;
+        }
+
+        destinations.push_back(dest);
+    }
+
+    std::vector<float> parameters(ParameterList.size(), std::numeric_limits<float>::quiet_NaN());
+
+    if (options.quality >= 0)
+    {
+        parameters[parameterListIndexOf(SynthParam::ID::HQMode)] =
+            static_cast<float>(options.quality);
+    }
+
+    std::unique_ptr<RenderCache> cache;
+    RenderPool pool(options.numWorkers, options.sampleRate);
+
+    if (options.cache != juce::File())
+    {
+        cache = std::make_unique<RenderCache>(options.cache, options.cacheMegabytes << 20);
+        pool.setCache(cache.get());
+    }
+
+    // Songs go to the pool a batch at a time, so long songs don't all sit in memory at once
+    const auto batchSize = static_cast<size_t>(pool.getNumWorkers()) * 2;
+    int failures{0}, rendered{0};
+
+    for (size_t first = 0; first < songs.size(); first += batchSize)
+    {
+        const auto last = std::min(songs.size(), first + batchSize);
+
+        std::vector<RenderPool::Job> jobs;
+        std::vector<std::vector<float>> buffers;
+        std::vector<size_t> jobSongs;
+        std::vector<int> songLengths;
+
+        for (auto s = first; s < last; ++s)
+        {
+            RenderPool::Job job;
+            int64_t length{0};
+            int programChanges{0};
+
+            if (!readMidiFile(songs[s], options.sampleRate, job.events, length, programChanges))
+            {
+                std::cerr << "could not read " << songs[s].getFullPathName() << std::endl;
+                ++failures;
+                continue;
+            }
+
+            if (programChanges > 0)
+            {
+                std::cerr << songs[s].getFileName() << ": ignoring " << programChanges
+                          << " program change(s), the whole song plays "
+                          << patch.getFileName() << std::endl;
+            }
+
+            const auto total = length + tailSamples;
+
+            if (total > std::numeric_limits<int>::max() / 2)
+            {
+                std::cerr << "too long to render: " << songs[s].getFullPathName() << std::endl;
+                ++failures;
+                continue;
+            }
+
+            job.patch = patch;
+            job.parameters = parameters;
+            job.seed = options.seed;
+            job.numSamples = static_cast<int>(total);
+
+            buffers.emplace_back(2 * static_cast<size_t>(job.numSamples));
+            jobs.push_back(std::move(job));
+            jobSongs.push_back(s);
+            songLengths.push_back(static_cast<int>(length));
+        }
+
+        for (size_t j = 0; j < jobs.size(); ++j)
+        {
+            jobs[j].left = buffers[j].data();
+            jobs[j].right = buffers[j].data() + jobs[j].numSamples;
+        }
+
+        pool.render(jobs);
+
+        for (size_t j = 0; j < jobs.size(); ++j)
+        {
+            const auto &song = songs[jobSongs[j]];
+            const auto &job = jobs[j];
+
+            if (!job.error.empty())
+            {
+                std::cerr << song.getFileName() << ": " << job.error << std::endl;
+                ++failures;
+                continue;
+            }
+
+            const auto &dest = destinations[jobSongs[j]];
+            const auto n = trimmedLength(job.left, job.right, job.numSamples, songLengths[j]);
+
+            if (!dest.getParentDirectory().createDirectory() ||
+                !writeAudioFile(dest, job.left, job.right, n, options))
+            {
+                std::cerr << "could not write " << dest.getFullPathName() << std::endl;
+                ++failures;
+                continue;
+            }
+
+            std::cout << song.getFileName() << " -> " << dest.getFullPathName() << " ("
+                      << juce::String(n / options.sampleRate, 2) << " s)" << std::endl;
+            ++rendered;
+        }
+    }
+
+    std::cout << "rendered " << rendered << " of " << songs.size() << " songs" << std::endl;
+
+    return failures > 0 ? 1 : 0;
+}
@@ -17,20 +17,158 @@
  */
 
 #include "ScalingImageCache.h"
+#include <algorithm>
+#include <cstring>
 #include <juce_core/juce_core.h>
 #include <juce_gui_basics/juce_gui_basics.h>
 #include "BinaryData.h"
+#include "SharedResources.h"
 
 constexpr std::array<int, 3> ScalingImageCache::zoomLevels;
 
-ScalingImageCache::ScalingImageCache(Utils &utilsRef) : utils(utilsRef) { setSkinDir(); }
+namespace
+{
+/*
+ * Raster cache file: "OBXR" | int32 version | int32 width | int32 height, then the rows
+ * of premultiplied ARGB pixels in the native pixel layout. Only ever read back on the
+ * machine which wrote it.
+ */
+constexpr char rasterMagic[4] = {'O', 'B', 'X', 'R'};
+constexpr int rasterVersion{1};
+constexpr size_t rasterHeaderSize{sizeof(rasterMagic) + 12};
+
+/*
+ * Rasters are touched whenever they are read back, and once the folder outgrows this the
+ * least recently used ones are deleted, which is also what clears out strips of themes
+ * and scales nobody shows any more.
+ */
+constexpr juce::int64 rasterCacheMaxBytes{juce::int64{512} << 20};
+
+juce::Image readRaster(const juce::File &file, const int w, const int h)
+{
+    juce::MemoryMappedFile mapped(file, juce::MemoryMappedFile::readOnly);
+    const auto rowBytes = static_cast<size_t>(w) * 4;
+
+    if (mapped.getData() == nullptr ||
+        mapped.getSize() != rasterHeaderSize + rowBytes * static_cast<size_t>(h) ||
+        std::memcmp(mapped.getData(), rasterMagic, sizeof(rasterMagic)) != 0)
+    {
+        return {};
+    }
+
+    juce::MemoryInputStream in(mapped.getData(), rasterHeaderSize, false);
+    in.skipNextBytes(sizeof(rasterMagic));
+
+    if (in.readInt() != rasterVersion || in.readInt() != w || in.readInt() != h)
+        return {};
+
+    juce::Image img(juce::Image::ARGB, w, h, false, juce::SoftwareImageType());
+    const juce::Image::BitmapData bits(img, juce::Image::BitmapData::writeOnly);
+    const auto *src = static_cast<const uint8_t *>(mapped.getData()) + rasterHeaderSize;
+
+    for (int y = 0; y < h; ++y)
+        std::memcpy(bits.getLinePointer(y), src + rowBytes * static_cast<size_t>(y), rowBytes);
+
+    return img;
+}
+
+bool writeRaster(const juce::File &file, const juce::Image &img)
+{
+    if (!file.getParentDirectory().createDirectory())
+        return false;
+
+    // Write aside and move into place, so another instance never maps a half written file
+    juce::TemporaryFile temp(file);
+
+    {
+        juce::FileOutputStream out(temp.getFile());
+
+        if (!out.openedOk())
+            return false;
+
+        out.write(rasterMagic, sizeof(rasterMagic));
+        out.writeInt(rasterVersion);
+        out.writeInt(img.getWidth());
+        out.writeInt(img.getHeight());
+
+        const juce::Image::BitmapData bits(img, juce::Image::BitmapData::readOnly);
+
+        for (int y = 0; y < img.getHeight(); ++y)
+            out.write(bits.getLinePointer(y), static_cast<size_t>(img.getWidth()) * 4);
+
+        out.flush();
+
+        if (out.getStatus().failed())
+            return false;
+    }
+
+    return temp.overwriteTargetFileWithTemporary();
+}
+
+// Strip renders give up as soon as the pool is torn down, see ScalingImageCache()
+bool filmstripCancelled()
+{
+    const auto *job = juce::ThreadPoolJob::getCurrentThreadPoolJob();
+    return job != nullptr && job->shouldExit();
+}
+
+void evictRasters(const juce::File &folder)
+{
+    std::vector<std::pair<juce::int64, juce::File>> byAge;
+    juce::int64 totalBytes{0};
+
+    for (const auto &f : folder.findChildFiles(juce::File::findFiles, false, "*.raster"))
+    {
+        byAge.emplace_back(f.getLastModificationTime().toMilliseconds(), f);
+        totalBytes += f.getSize();
+    }
+
+    if (totalBytes <= rasterCacheMaxBytes)
+        return;
+
+    std::sort(byAge.begin(), byAge.end(),
+              [](const auto &a, const auto &b) { return a.first < b.first; });
+
+    for (const auto &[lastUse, f] : byAge)
+    {
+        if (totalBytes <= rasterCacheMaxBytes)
+            break;
+
+        // Another instance may be evicting alongside us, or be reading the file back. A
+        // reader only maps it long enough to copy it out; on POSIX unlinking it leaves that
+        // mapping intact, on Windows the delete fails and the file simply stays for now
+        const auto size = f.getSize();
+
+        if (f.deleteFile())
+            totalBytes -= size;
+    }
+}
+} // namespace
+
+ScalingImageCache::ScalingImageCache(Utils &utilsRef) : utils(utilsRef)
+{
+    setSkinDir();
+    setTheme(false, skinDir);
+
+    // shared by every editor, so all the strips a theme needs render side by side. The last
+    // editor to close tears it down on the message thread, so rather than waiting for the
+    // renders in flight it interrupts them
+    filmstripRenderer = obxf::SharedResources::acquire<juce::ThreadPool>("filmstrips", []() {
+        return std::shared_ptr<juce::ThreadPool>(
+            new juce::ThreadPool(juce::jmax(1, juce::SystemStats::getNumCpus() / 2)),
+            [](juce::ThreadPool *pool) {
+                pool->removeAllJobs(true, filmstripShutdownMs);
+                delete pool;
+            });
+    });
+}
 
 bool ScalingImageCache::hasImageFor(const std::string &label)
 {
     initializeImage(label);
-    if (cachePaths.find(label) == cachePaths.end())
+    if (images->cachePaths.find(label) == images->cachePaths.end())
         return false;
-    return cachePaths[label].find(baseZoomLevel) != cachePaths[label].end();
+    return images->cachePaths[label].find(baseZoomLevel) != images->cachePaths[label].end();
 }
 
 juce::Image ScalingImageCache::getImageFor(const std::string &label, const int w, const int h)
@@ -38,7 +176,7 @@ juce::Image ScalingImageCache::getImageFor(const std::string &label, const int w
     initializeImage(label);
     const int zl = zoomLevelFor(label, w, h);
     guaranteeImageFor(label, zl);
-    auto &imgMap = cacheImages[label];
+    auto &imgMap = images->cacheImages[label];
 
     if (const auto it = imgMap.find(zl); it != imgMap.end() && it->second.has_value())
         return *(it->second);
@@ -50,14 +188,20 @@ juce::Image ScalingImageCache::getImageFor(const std::string &label, const int w
     return {};
 }
 
-void ScalingImageCache::clearCache()
+void ScalingImageCache::setTheme(bool embedded, const juce::File &dir, bool reload)
 {
-    cacheImages.clear();
-    cachePaths.clear();
-    cacheSizes.clear();
+    embeddedMode = embedded;
+    skinDir = embedded ? juce::File() : dir;
+
+    const auto key = embedded ? std::string("embedded") : skinDir.getFullPathName().toStdString();
+
+    if (reload)
+    {
+        obxf::SharedResources::invalidate<ImageSet>(key);
+    }
 
-    svgLayers.clear();
-    svgLayerCount.clear();
+    images = obxf::SharedResources::acquire<ImageSet>(
+        key, []() { return std::make_shared<ImageSet>(); });
 }
 
 juce::Image ScalingImageCache::initializeImage(const std::string &label)
@@ -65,14 +209,14 @@ juce::Image ScalingImageCache::initializeImage(const std::string &label)
     if (label.empty())
         return {};
 
-    if (cachePaths.find(label) != cachePaths.end())
+    if (images->cachePaths.find(label) != images->cachePaths.end())
     {
         // cachePaths exists but svgLayers might not if a previous call
         // populated paths but was interrupted before svg loading
-        if (svgLayers.find(label) == svgLayers.end())
+        if (images->svgLayers.find(label) == images->svgLayers.end())
         {
             // don't early-exit, fall through to re-populate svgLayers
-            cachePaths.erase(label);
+            images->cachePaths.erase(label);
         }
         else
             return {};
@@ -101,10 +245,10 @@ juce::Image ScalingImageCache::initializeImage(const std::string &label)
         };
         if (res)
         {
-            svgLayerCount[label] = 1;
-            svgLayers[label].clear();
-            svgLayers[label].push_back(svgFrom(res, sz));
-            cachePaths[label][baseZoomLevel] = juce::File("/" + xformLab + "_svg");
+            images->svgLayerCount[label] = 1;
+            images->svgLayers[label].clear();
+            images->svgLayers[label].push_back(svgFrom(res, sz));
+            images->cachePaths[label][baseZoomLevel] = juce::File("/" + xformLab + "_svg");
             return {};
         }
 
@@ -112,21 +256,21 @@ juce::Image ScalingImageCache::initializeImage(const std::string &label)
         if (res)
         {
             int layerCount = 1;
-            svgLayers[label].clear();
-            cachePaths[label][baseZoomLevel] = juce::File("/" + xformLab + "_svg");
-            svgLayers[label].push_back(svgFrom(res, sz));
+            images->svgLayers[label].clear();
+            images->cachePaths[label][baseZoomLevel] = juce::File("/" + xformLab + "_svg");
+            images->svgLayers[label].push_back(svgFrom(res, sz));
 
             std::string nextLayer = xformLab + "layer" + std::to_string(layerCount + 1) + "_svg";
             res = BinaryData::getNamedResource(nextLayer.c_str(), sz);
             while (res)
             {
                 layerCount++;
-                svgLayers[label].push_back(svgFrom(res, sz));
+                images->svgLayers[label].push_back(svgFrom(res, sz));
 
                 nextLayer = xformLab + "layer" + std::to_string(layerCount + 1) + "_svg";
                 res = BinaryData::getNamedResource(nextLayer.c_str(), sz);
             }
-            svgLayerCount[label] = layerCount;
+            images->svgLayerCount[label] = layerCount;
             return {};
         }
 
@@ -141,7 +285,7 @@ juce::Image ScalingImageCache::initializeImage(const std::string &label)
 
     if (const juce::File basePath = skinDir.getChildFile(label + ".png"); basePath.existsAsFile())
     {
-        cachePaths[label][baseZoomLevel] = basePath;
+        images->cachePaths[label][baseZoomLevel] = basePath;
 
         for (int zl : zoomLevels)
         {
@@ -150,41 +294,41 @@ juce::Image ScalingImageCache::initializeImage(const std::string &label)
 
             std::string suffix = fmt::format("@{}x", zl / baseZoomLevel);
             if (juce::File zp = skinDir.getChildFile(label + suffix + ".png"); zp.existsAsFile())
-                cachePaths[label][zl] = zp;
+                images->cachePaths[label][zl] = zp;
         }
 
         juce::Image img = juce::ImageCache::getFromFile(basePath);
-        cacheImages[label][baseZoomLevel] = img;
+        images->cacheImages[label][baseZoomLevel] = img;
 
         if (img.isValid())
-            cacheSizes[label] = {img.getWidth(), img.getHeight()};
+            images->cacheSizes[label] = {img.getWidth(), img.getHeight()};
         return img;
     }
 
     if (const juce::File basePath = skinDir.getChildFile(label + ".svg"); basePath.existsAsFile())
     {
-        svgLayerCount[label] = 1;
-        cachePaths[label][baseZoomLevel] = basePath;
-        svgLayers[label].push_back(juce::Drawable::createFromSVGFile(basePath));
+        images->svgLayerCount[label] = 1;
+        images->cachePaths[label][baseZoomLevel] = basePath;
+        images->svgLayers[label].push_back(juce::Drawable::createFromSVGFile(basePath));
         gotImage = true;
     }
     else if (const juce::File basePath = skinDir.getChildFile(label + "-layer1.svg");
              basePath.existsAsFile())
     {
         int layerCount = 1;
-        cachePaths[label][baseZoomLevel] = basePath;
-        svgLayers[label].push_back(juce::Drawable::createFromSVGFile(basePath));
+        images->cachePaths[label][baseZoomLevel] = basePath;
+        images->svgLayers[label].push_back(juce::Drawable::createFromSVGFile(basePath));
 
         juce::File lPath =
             skinDir.getChildFile(label + "-layer" + std::to_string(layerCount + 1) + ".svg");
         while (lPath.existsAsFile())
         {
             layerCount++;
-            svgLayers[label].push_back(juce::Drawable::createFromSVGFile(lPath));
+            images->svgLayers[label].push_back(juce::Drawable::createFromSVGFile(lPath));
             lPath =
                 skinDir.getChildFile(label + "-layer" + std::to_string(layerCount + 1) + ".svg");
         }
-        svgLayerCount[label] = layerCount;
+        images->svgLayerCount[label] = layerCount;
         gotImage = true;
     }
 
@@ -217,13 +361,13 @@ std::unique_ptr<juce::Drawable> ScalingImageCache::getEmbeddedVectorDrawable(con
 
 int ScalingImageCache::zoomLevelFor(const std::string &label, const int w, int /*h*/)
 {
-    if (cacheSizes.find(label) == cacheSizes.end())
+    if (images->cacheSizes.find(label) == images->cacheSizes.end())
         return baseZoomLevel;
 
     double scale = juce::Desktop::getInstance().getDisplays().getPrimaryDisplay()->scale;
     // this gets the right scale assets but we dont' end up getting the right position on win
     scale *= utils.getPluginAPIScale();
-    auto base = cacheSizes[label];
+    auto base = images->cacheSizes[label];
     const double mu = scale * (static_cast<float>(w) / static_cast<float>(base.first));
 
     int chosenZoom;
@@ -234,10 +378,10 @@ int ScalingImageCache::zoomLevelFor(const std::string &label, const int w, int /
     else
         chosenZoom = zoomLevels[2];
 
-    if (cachePaths[label].find(chosenZoom) != cachePaths[label].end())
+    if (images->cachePaths[label].find(chosenZoom) != images->cachePaths[label].end())
         return chosenZoom;
 
-    for (auto it = cachePaths[label].rbegin(); it != cachePaths[label].rend(); ++it)
+    for (auto it = images->cachePaths[label].rbegin(); it != images->cachePaths[label].rend(); ++it)
     {
         if (it->second.existsAsFile())
             return it->first;
@@ -248,17 +392,13 @@ int ScalingImageCache::zoomLevelFor(const std::string &label, const int w, int /
 
 void ScalingImageCache::guaranteeImageFor(const std::string &label, const int zoomLevel)
 {
-    auto &imgMap = cacheImages[label];
+    auto &imgMap = images->cacheImages[label];
 
-    for (auto it = imgMap.begin(); it != imgMap.end();)
-    {
-        if (it->first != zoomLevel)
-            it = imgMap.erase(it);
-        else
-            ++it;
-    }
+    // other instances may be showing this theme at another zoom, so keep what is loaded
+    if (const auto it = imgMap.find(zoomLevel); it != imgMap.end() && it->second.has_value())
+        return;
 
-    auto &pathMap = cachePaths[label];
+    auto &pathMap = images->cachePaths[label];
 
     if (const auto it = pathMap.find(zoomLevel); it != pathMap.end())
     {
@@ -276,13 +416,13 @@ void ScalingImageCache::setSkinDir()
 bool ScalingImageCache::isSVG(const std::string &label)
 {
     initializeImage(label);
-    return svgLayers.find(label) != svgLayers.end();
+    return images->svgLayers.find(label) != images->svgLayers.end();
 }
 
 int ScalingImageCache::getSvgLayerCount(const std::string &label)
 {
-    auto p = svgLayerCount.find(label);
-    if (p != svgLayerCount.end())
+    auto p = images->svgLayerCount.find(label);
+    if (p != images->svgLayerCount.end())
         return p->second;
     else
         return 0;
@@ -292,5 +432,151 @@ std::unique_ptr<juce::Drawable> &ScalingImageCache::getSVGDrawable(const std::st
                                                                    int layer)
 {
     initializeImage(label);
-    return svgLayers[label][layer];
+    return images->svgLayers[label][layer];
+}
+
+const ScalingImageCache::SvgLayers &ScalingImageCache::getSVGLayers(const std::string &label)
+{
+    initializeImage(label);
+    return images->svgLayers[label];
+}
+
+juce::Image ScalingImageCache::getFilmstrip(const std::string &label, const std::string &variant,
+                                            const int w, const int h, const float pixelScale,
+                                            FramePainter painter)
+{
+    const int pw = juce::roundToInt(static_cast<float>(w) * pixelScale);
+    const int ph = juce::roundToInt(static_cast<float>(h) * pixelScale);
+
+    if (pw <= 0 || ph <= 0 || !isSVG(label))
+        return {};
+
+    const auto key = fmt::format("{}|{}|{}x{}", label, variant, pw, ph);
+
+    if (const auto it = images->filmstrips.find(key); it != images->filmstrips.end())
+        return it->second;
+
+    // rendered before, by this or an earlier session
+    const auto rasterFile = rasterCacheFileFor(label, key);
+
+    if (auto cached = readRaster(rasterFile, pw, ph * filmstripFrames); cached.isValid())
+    {
+        rasterFile.setLastModificationTime(juce::Time::getCurrentTime());
+        images->filmstrips[key] = cached;
+        return cached;
+    }
+
+    images->filmstrips[key] = {};
+
+    // the worker gets copies, the cached drawables are only ever touched on this thread
+    auto layers = std::make_shared<SvgLayers>();
+
+    for (const auto &l : images->svgLayers[label])
+        layers->push_back(l ? l->createCopy() : nullptr);
+
+    filmstripRenderer->addJob([layers, painter = std::move(painter), w, h, pw, ph, key,
+                               rasterFile, set = std::weak_ptr<ImageSet>(images)]() {
+        juce::Image strip(juce::Image::ARGB, pw, ph * filmstripFrames, true,
+                          juce::SoftwareImageType());
+
+        {
+            juce::Graphics g(strip);
+            const auto toPixels = juce::AffineTransform::scale(static_cast<float>(pw) / w,
+                                                               static_cast<float>(ph) / h);
+
+            for (int i = 0; i < filmstripFrames; ++i)
+            {
+                if (filmstripCancelled())
+                    break;
+
+                juce::Graphics::ScopedSaveState state(g);
+
+                g.reduceClipRegion(0, i * ph, pw, ph);
+                g.addTransform(toPixels.translated(0.f, static_cast<float>(i * ph)));
+
+                painter(g, *layers, static_cast<float>(i) / (filmstripFrames - 1));
+            }
+        }
+
+        layers->clear();
+
+        // an unfinished strip is never cached; forget it, so whoever asks next renders it
+        if (filmstripCancelled())
+        {
+            juce::MessageManager::callAsync([set, key]() {
+                if (const auto s = set.lock())
+                    s->filmstrips.erase(key);
+            });
+
+            return;
+        }
+
+        if (writeRaster(rasterFile, strip))
+            evictRasters(rasterFile.getParentDirectory());
+
+        juce::MessageManager::callAsync([set, key, strip]() {
+            if (const auto s = set.lock())
+                s->filmstrips[key] = strip;
+        });
+    });
+
+    return {};
+}
+
+juce::File ScalingImageCache::rasterCacheFileFor(const std::string &label,
+                                                 const std::string &key)
+{
+    using obxf::SharedResources;
+
+    // Stamp the sources of the label, so editing a theme's SVGs never shows stale rasters
+    auto h = SharedResources::hashContents(key.data(), key.size());
+
+    if (embeddedMode)
+    {
+        std::string xformLab{};
+        for (auto c : label)
+        {
+            if (c == '-')
+                continue;
+            xformLab.push_back(c);
+        }
+
+        int sz{0};
+
+        for (int layer = 0;; ++layer)
+        {
+            const auto name =
+                layer == 0 ? xformLab + "_svg" : fmt::format("{}layer{}_svg", xformLab, layer);
+
+            if (const auto *res = BinaryData::getNamedResource(name.c_str(), sz))
+                h = SharedResources::hashContents(res, static_cast<size_t>(sz), h);
+            else if (layer > 0)
+                break;
+        }
+    }
+    else
+    {
+        for (int layer = 0;; ++layer)
+        {
+            const auto f = skinDir.getChildFile(
+                layer == 0 ? label + ".svg" : fmt::format("{}-layer{}.svg", label, layer));
+
+            if (!f.existsAsFile())
+            {
+                if (layer > 0)
+                    break;
+
+                continue;
+            }
+
+            const auto stamp = fmt::format("{}|{}|{}", f.getFullPathName().toStdString(),
+                                           f.getLastModificationTime().toMilliseconds(),
+                                           f.getSize());
+            h = SharedResources::hashContents(stamp.data(), stamp.size(), h);
+        }
+    }
+
+    return utils.getDocumentFolder()
+        .getChildFile("RasterCache")
+        .getChildFile(juce::String::toHexString(static_cast<juce::int64>(h)) + ".raster");
 }
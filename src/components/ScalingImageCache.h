@@ -19,6 +19,7 @@
 #ifndef OBXF_SRC_COMPONENTS_SCALINGIMAGECACHE_H
 #define OBXF_SRC_COMPONENTS_SCALINGIMAGECACHE_H
 #include <juce_graphics/juce_graphics.h>
+#include <functional>
 #include <unordered_map>
 #include <map>
 #include <string>
@@ -34,25 +35,58 @@ struct ScalingImageCache
     bool hasImageFor(const std::string &label);
     juce::Image getImageFor(const std::string &label, int w, int h);
     int zoomLevelFor(const std::string &label, int w, int h);
-    void clearCache();
+
+    // Points the cache at a theme. What gets decoded is shared with every other instance
+    // showing the same theme; reload drops that so the theme is read from disk again
+    void setTheme(bool embedded, const juce::File &dir, bool reload = false);
     juce::File skinDir;
     bool embeddedMode{false};
 
     // A utility to *always* get from embedded no matter what
     std::unique_ptr<juce::Drawable> getEmbeddedVectorDrawable(const std::string &l);
 
+    using SvgLayers = std::vector<std::unique_ptr<juce::Drawable>>;
+    const SvgLayers &getSVGLayers(const std::string &label);
+
+    /*
+     * Frames of an SVG control pre-rendered into one vertical strip, so painting it is a
+     * single blit rather than rasterizing its layers. painter draws the frame for a value
+     * into a w x h area; it runs on a worker thread with its own copies of the layers, so
+     * it must not capture anything from the control. Until the strip has been rendered
+     * this returns an invalid image and the caller paints the vectors itself.
+     */
+    using FramePainter = std::function<void(juce::Graphics &, const SvgLayers &, float v01)>;
+    static constexpr int filmstripFrames{128};
+    // how long closing the last editor waits for interrupted strip renders to wind down
+    static constexpr int filmstripShutdownMs{250};
+    juce::Image getFilmstrip(const std::string &label, const std::string &variant, int w, int h,
+                             float pixelScale, FramePainter painter);
+
   private:
     juce::Image initializeImage(const std::string &label);
     void guaranteeImageFor(const std::string &label, int zoomLevel);
     void setSkinDir();
+    // Where the raster for a filmstrip key is cached on disk
+    juce::File rasterCacheFileFor(const std::string &label, const std::string &key);
     Utils &utils;
 
-    std::unordered_map<std::string, int> svgLayerCount;
-    std::unordered_map<std::string, std::vector<std::unique_ptr<juce::Drawable>>> svgLayers;
+    // Everything decoded for one theme. Only touched on the message thread, and the
+    // drawables are only ever drawn, so instances can share it as is
+    struct ImageSet
+    {
+        std::unordered_map<std::string, int> svgLayerCount;
+        std::unordered_map<std::string, std::vector<std::unique_ptr<juce::Drawable>>> svgLayers;
+
+        std::unordered_map<std::string, std::map<int, juce::File>> cachePaths;
+        std::unordered_map<std::string, std::map<int, std::optional<juce::Image>>> cacheImages;
+        std::unordered_map<std::string, std::pair<int, int>> cacheSizes;
+
+        // invalid while still rendering
+        std::unordered_map<std::string, juce::Image> filmstrips;
+    };
 
-    std::unordered_map<std::string, std::map<int, juce::File>> cachePaths;
-    std::unordered_map<std::string, std::map<int, std::optional<juce::Image>>> cacheImages;
-    std::unordered_map<std::string, std::pair<int, int>> cacheSizes;
+    std::shared_ptr<ImageSet> images;
+    std::shared_ptr<juce::ThreadPool> filmstripRenderer;
     static constexpr std::array<int, 3> zoomLevels = {100, 200, 400};
     static constexpr int baseZoomLevel = 100;
 };
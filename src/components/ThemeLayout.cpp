@@ -0,0 +1,187 @@
+/*
+ * OB-Xd was originally written by Vadim Filatov, and then a version
+ * was released under the GPL3 at https://github.com/reales/OB-Xd.
+ * Subsequently, the product was continued by DiscoDSP and the copyright
+ * holders as an excellent closed source product.
+ *
+ * This repository is a successor to OB-Xd version 2.11.
+ * Copyright 2013-2025 by the authors as indicated in the original release,
+ * and subsequent authors as per GitHub transaction log.
+ *
+ * OB-Xf is released under the GNU General Public Licence v3 or later
+ * (GPL-3.0-or-later). The license is found in the file "LICENSE"
+ * in the root of this repository or at:
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * Source code is available at https://github.com/surge-synthesizer/OB-Xf
+ */
+
+#include "ThemeLayout.h"
+
+#include <cstring>
+
+#include "SharedResources.h"
+
+std::shared_ptr<ThemeLayout> ThemeLayout::compile(const juce::XmlElement &doc)
+{
+    auto res = std::make_shared<ThemeLayout>();
+
+    if (doc.getTagName() != "obxf-theme")
+    {
+        return res;
+    }
+
+    res->isTheme = true;
+
+    for (const auto *child : doc.getChildWithTagNameIterator("widget"))
+    {
+        Widget w;
+
+        w.name = child->getStringAttribute("name");
+        w.x = child->getIntAttribute("x");
+        w.y = child->getIntAttribute("y");
+        w.w = child->getIntAttribute("w");
+        w.h = child->getIntAttribute("h");
+        w.d = child->getIntAttribute("d");
+        w.fh = child->getIntAttribute("fh");
+        w.pic = child->getStringAttribute("pic");
+        w.hasColor = child->hasAttribute("color");
+        w.color = child->getStringAttribute("color", "FFFF0000").getHexValue32();
+
+        res->widgets.push_back(std::move(w));
+    }
+
+    return res;
+}
+
+bool ThemeLayout::write(const juce::File &cacheFile) const
+{
+    if (!cacheFile.getParentDirectory().createDirectory())
+    {
+        return false;
+    }
+
+    // Write aside and move into place, so another instance never reads a half written file
+    juce::TemporaryFile temp(cacheFile);
+
+    {
+        juce::FileOutputStream out(temp.getFile());
+
+        if (!out.openedOk())
+        {
+            return false;
+        }
+
+        out.write(magic, sizeof(magic));
+        out.writeInt(version);
+        out.writeInt64(static_cast<juce::int64>(contentHash));
+        out.writeBool(isTheme);
+        out.writeInt(static_cast<int>(widgets.size()));
+
+        for (const auto &w : widgets)
+        {
+            out.writeString(w.name);
+
+            for (auto v : {w.x, w.y, w.w, w.h, w.d, w.fh})
+            {
+                out.writeInt(v);
+            }
+
+            out.writeString(w.pic);
+            out.writeInt(static_cast<int>(w.color));
+            out.writeBool(w.hasColor);
+        }
+
+        out.flush();
+
+        if (out.getStatus().failed())
+        {
+            return false;
+        }
+    }
+
+    return temp.overwriteTargetFileWithTemporary();
+}
+
+std::shared_ptr<ThemeLayout> ThemeLayout::read(const juce::File &cacheFile, uint64_t contentHash)
+{
+    if (!cacheFile.existsAsFile())
+    {
+        return nullptr;
+    }
+
+    juce::MemoryMappedFile mapped(cacheFile, juce::MemoryMappedFile::readOnly);
+
+    if (mapped.getData() == nullptr || mapped.getSize() < sizeof(magic) + 17 ||
+        std::memcmp(mapped.getData(), magic, sizeof(magic)) != 0)
+    {
+        return nullptr;
+    }
+
+    juce::MemoryInputStream in(mapped.getData(), mapped.getSize(), false);
+    in.skipNextBytes(sizeof(magic));
+
+    if (in.readInt() != version || static_cast<uint64_t>(in.readInt64()) != contentHash)
+    {
+        return nullptr;
+    }
+
+    auto res = std::make_shared<ThemeLayout>();
+    res->contentHash = contentHash;
+    res->isTheme = in.readBool();
+
+    const auto n = in.readInt();
+
+    // every widget takes at least 31 bytes
+    if (n < 0 || in.getNumBytesRemaining() < static_cast<juce::int64>(n) * 31)
+    {
+        return nullptr;
+    }
+
+    res->widgets.resize(static_cast<size_t>(n));
+
+    for (auto &w : res->widgets)
+    {
+        w.name = in.readString();
+
+        for (auto *v : {&w.x, &w.y, &w.w, &w.h, &w.d, &w.fh})
+        {
+            *v = in.readInt();
+        }
+
+        w.pic = in.readString();
+        w.color = static_cast<juce::uint32>(in.readInt());
+        w.hasColor = in.readBool();
+    }
+
+    return res;
+}
+
+std::shared_ptr<const ThemeLayout> ThemeLayout::load(const juce::MemoryBlock &themeXml,
+                                                     const juce::File &cacheFile)
+{
+    const auto hash =
+        obxf::SharedResources::hashContents(themeXml.getData(), themeXml.getSize());
+    const auto key = juce::String::toHexString(static_cast<juce::int64>(hash)).toStdString();
+
+    return obxf::SharedResources::acquire<const ThemeLayout>(
+        key, [&]() -> std::shared_ptr<const ThemeLayout> {
+            if (auto cached = read(cacheFile, hash))
+            {
+                return cached;
+            }
+
+            const auto doc = juce::XmlDocument::parse(themeXml.toString());
+
+            if (!doc)
+            {
+                return nullptr;
+            }
+
+            auto layout = compile(*doc);
+            layout->contentHash = hash;
+            layout->write(cacheFile);
+
+            return layout;
+        });
+}
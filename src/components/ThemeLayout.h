@@ -0,0 +1,69 @@
+/*
+ * OB-Xd was originally written by Vadim Filatov, and then a version
+ * was released under the GPL3 at https://github.com/reales/OB-Xd.
+ * Subsequently, the product was continued by DiscoDSP and the copyright
+ * holders as an excellent closed source product.
+ *
+ * This repository is a successor to OB-Xd version 2.11.
+ * Copyright 2013-2025 by the authors as indicated in the original release,
+ * and subsequent authors as per GitHub transaction log.
+ *
+ * OB-Xf is released under the GNU General Public Licence v3 or later
+ * (GPL-3.0-or-later). The license is found in the file "LICENSE"
+ * in the root of this repository or at:
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * Source code is available at https://github.com/surge-synthesizer/OB-Xf
+ */
+
+#ifndef OBXF_SRC_COMPONENTS_THEMELAYOUT_H
+#define OBXF_SRC_COMPONENTS_THEMELAYOUT_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <juce_core/juce_core.h>
+
+/*
+ * theme.xml compiled down to what the editor actually reads from it: one entry per
+ * widget with its bounds, image and colour. Compiled layouts are kept on disk with a
+ * hash of the theme.xml contents they came from, so the XML is only parsed again when
+ * a theme is new or was edited, and are shared in memory between instances.
+ */
+struct ThemeLayout
+{
+    struct Widget
+    {
+        juce::String name;
+        int x{0}, y{0}, w{0}, h{0}, d{0}, fh{0};
+        juce::String pic;
+        juce::uint32 color{0xFFFF0000};
+        bool hasColor{false};
+    };
+
+    uint64_t contentHash{0};
+    // false if the document was well formed XML but not an obxf-theme
+    bool isTheme{false};
+    std::vector<Widget> widgets;
+
+    static std::shared_ptr<ThemeLayout> compile(const juce::XmlElement &doc);
+
+    bool write(const juce::File &cacheFile) const;
+    // nullptr if the file is missing, damaged or was compiled from other contents
+    static std::shared_ptr<ThemeLayout> read(const juce::File &cacheFile, uint64_t contentHash);
+
+    /*
+     * The layout for the given theme.xml contents: the one another instance already holds,
+     * else the one in the cache file, else compiled from the XML (and written to the cache
+     * file). nullptr if the XML can't be parsed.
+     */
+    static std::shared_ptr<const ThemeLayout> load(const juce::MemoryBlock &themeXml,
+                                                   const juce::File &cacheFile);
+
+  private:
+    static constexpr char magic[4] = {'O', 'B', 'X', 'T'};
+    static constexpr int version{1};
+};
+
+#endif // OBXF_SRC_COMPONENTS_THEMELAYOUT_H
@@ -0,0 +1,401 @@
+/*
+ * OB-Xd was originally written by Vadim Filatov, and then a version
+ * was released under the GPL3 at https://github.com/reales/OB-Xd.
+ * Subsequently, the product was continued by DiscoDSP and the copyright
+ * holders as an excellent closed source product.
+ *
+ * This repository is a successor to OB-Xd version 2.11.
+ * Copyright 2013-2025 by the authors as indicated in the original release,
+ * and subsequent authors as per GitHub transaction log.
+ *
+ * OB-Xf is released under the GNU General Public Licence v3 or later
+ * (GPL-3.0-or-later). The license is found in the file "LICENSE"
+ * in the root of this repository or at:
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * Source code is available at https://github.com/surge-synthesizer/OB-Xf
+ */
+
+
+#include "DatasetGenerator.h"
+
+#include <cmath>
+#include <cstring>
+
+#include <juce_audio_formats/juce_audio_formats.h>
+
+#include "RenderPool.h"
+
+namespace
+{
+int countNotes(int lowest, int highest, int step)
+{
+    if (step <= 0 || highest < lowest)
+    {
+        return 0;
+    }
+
+    return (highest - lowest) / step + 1;
+}
+
+bool writeTextAtomically(const juce::File &f, const juce::String &text)
+{
+    juce::TemporaryFile temp(f);
+
+    if (!temp.getFile().replaceWithText(text))
+    {
+        return false;
+    }
+
+    return temp.overwriteTargetFileWithTemporary();
+}
+
+bool writeWav(const juce::File &f, const float *left, const float *right, int numSamples,
+              double sampleRate)
+{
+    juce::WavAudioFormat wav;
+    auto stream = f.createOutputStream();
+
+    if (!stream)
+    {
+        return false;
+    }
+
+    std::unique_ptr<juce::AudioFormatWriter> writer(
+        wav.createWriterFor(stream.get(), sampleRate, 2, 32, {}, 0));
+
+    if (!writer)
+    {
+        return false;
+    }
+
+    // the writer owns the stream now
+    stream.release();
+
+    const float *channels[2] = {left, right};
+
+    return writer->writeFromFloatArrays(channels, 2, numSamples);
+}
+} // namespace
+
+int DatasetGenerator::Spec::numItems() const
+{
+    return static_cast<int>(patches.size()) * countNotes(lowestNote, highestNote, noteStep) *
+           static_cast<int>(velocities.size());
+}
+
+int DatasetGenerator::Spec::numSamples() const
+{
+    return static_cast<int>(std::ceil((noteSeconds + tailSeconds) * sampleRate));
+}
+
+juce::var DatasetGenerator::Spec::toVar() const
+{
+    auto *o = new juce::DynamicObject();
+    juce::Array<juce::var> patchPaths, velocityList;
+
+    for (const auto &p : patches)
+    {
+        patchPaths.add(p.getFullPathName());
+    }
+
+    for (auto v : velocities)
+    {
+        velocityList.add(v);
+    }
+
+    o->setProperty("patches", patchPaths);
+    o->setProperty("lowest_note", lowestNote);
+    o->setProperty("highest_note", highestNote);
+    o->setProperty("note_step", noteStep);
+    o->setProperty("velocities", velocityList);
+    o->setProperty("note_seconds", noteSeconds);
+    o->setProperty("tail_seconds", tailSeconds);
+    o->setProperty("sample_rate", sampleRate);
+    o->setProperty("samples", numSamples());
+    o->setProperty("shard_size", shardSize);
+    o->setProperty("format", format == Wav ? "wav" : "npy");
+    o->setProperty("seed", static_cast<juce::int64>(seed));
+
+    return juce::var(o);
+}
+
+DatasetGenerator::DatasetGenerator(const Spec &s, const juce::File &outputFolder)
+    : spec(s), folder(outputFolder)
+{
+    for (int n = spec.lowestNote; spec.noteStep > 0 && n <= spec.highestNote; n += spec.noteStep)
+    {
+        notes.push_back(n);
+    }
+}
+
+DatasetGenerator::Item DatasetGenerator::itemAt(int index) const
+{
+    const auto numVelocities = static_cast<int>(spec.velocities.size());
+    const auto perPatch = static_cast<int>(notes.size()) * numVelocities;
+
+    Item it;
+    it.patch = index / perPatch;
+    it.note = notes[static_cast<size_t>((index % perPatch) / numVelocities)];
+    it.velocity = spec.velocities[static_cast<size_t>(index % numVelocities)];
+
+    return it;
+}
+
+juce::File DatasetGenerator::shardFile(int shard, const juce::String &extension) const
+{
+    return folder.getChildFile("shard-" + juce::String(shard).paddedLeft('0', 5) + extension);
+}
+
+bool DatasetGenerator::writeNpy(const juce::File &f, const float *data, int rows, int samples)
+{
+    // npy format version 1.0: magic, version, header length, then a Python dict literal
+    // padded with spaces so the data starts on a 64 byte boundary
+    juce::String header = "{'descr': '<f4', 'fortran_order': False, 'shape': (" +
+                          juce::String(rows) + ", 2, " + juce::String(samples) + "), }";
+
+    const auto unpadded = 10 + header.length() + 1;
+    header += juce::String::repeatedString(" ", (64 - unpadded % 64) % 64) + "\n";
+
+    juce::TemporaryFile temp(f);
+
+    {
+        juce::FileOutputStream out(temp.getFile());
+
+        if (!out.openedOk())
+        {
+            return false;
+        }
+
+        out.write("\x93NUMPY\x01\x00", 8);
+        out.writeShort(static_cast<short>(header.length()));
+        out.write(header.toRawUTF8(), static_cast<size_t>(header.length()));
+
+        // floats are written as they are in memory, which is little endian on every target
+        out.write(data, static_cast<size_t>(rows) * 2 * static_cast<size_t>(samples) *
+                            sizeof(float));
+        out.flush();
+
+        if (out.getStatus().failed())
+        {
+            return false;
+        }
+    }
+
+    return temp.overwriteTargetFileWithTemporary();
+}
+
+DatasetGenerator::Result DatasetGenerator::run(int numWorkers, const ProgressCallback &progress,
+                                               const std::atomic<bool> *cancel)
+{
+    Result res;
+
+    const auto numItems = spec.numItems();
+    const auto numSamples = spec.numSamples();
+    const auto noteSamples = static_cast<int64_t>(std::llround(spec.noteSeconds * spec.sampleRate));
+
+    if (numItems <= 0 || spec.shardSize <= 0 || numSamples <= 0 || spec.sampleRate <= 0.0)
+    {
+        res.error = "The spec renders nothing";
+        return res;
+    }
+
+    for (auto n : notes)
+    {
+        if (n < 0 || n > 127)
+        {
+            res.error = "Notes must be between 0 and 127";
+            return res;
+        }
+    }
+
+    for (auto v : spec.velocities)
+    {
+        if (v < 1 || v > 127)
+        {
+            res.error = "Velocities must be between 1 and 127";
+            return res;
+        }
+    }
+
+    if (!folder.createDirectory())
+    {
+        res.error = "Could not create " + folder.getFullPathName().toStdString();
+        return res;
+    }
+
+    // A resumed run has to render exactly the same items, or the shards won't line up
+    const auto specText = juce::JSON::toString(spec.toVar());
+    const auto specFile = folder.getChildFile("spec.json");
+
+    if (specFile.existsAsFile())
+    {
+        if (juce::JSON::toString(juce::JSON::parse(specFile)) != specText)
+        {
+            res.error = "The output folder holds a dataset with a different spec";
+            return res;
+        }
+    }
+    else if (!writeTextAtomically(specFile, specText))
+    {
+        res.error = "Could not write " + specFile.getFullPathName().toStdString();
+        return res;
+    }
+
+    res.shards = (numItems + spec.shardSize - 1) / spec.shardSize;
+
+    std::unique_ptr<RenderPool> pool;
+    std::vector<float> audio;
+
+    for (int shard = 0; shard < res.shards; ++shard)
+    {
+        if (cancel && cancel->load())
+        {
+            break;
+        }
+
+        if (shardFile(shard, ".json").existsAsFile())
+        {
+            ++res.skippedShards;
+        }
+        else
+        {
+            // nothing is allocated or started when every shard is already there
+            if (!pool)
+            {
+                pool = std::make_unique<RenderPool>(numWorkers, spec.sampleRate);
+                audio.resize(static_cast<size_t>(spec.shardSize) * 2 *
+                             static_cast<size_t>(numSamples));
+            }
+
+            const auto first = shard * spec.shardSize;
+            const auto rows = std::min(spec.shardSize, numItems - first);
+            std::vector<RenderPool::Job> jobs(static_cast<size_t>(rows));
+
+            for (int r = 0; r < rows; ++r)
+            {
+                const auto it = itemAt(first + r);
+                auto &job = jobs[static_cast<size_t>(r)];
+
+                job.patch = spec.patches[static_cast<size_t>(it.patch)];
+                job.events = {
+                    {0, RenderEvent::NoteOn, 0, static_cast<uint16_t>(it.note),
+                     static_cast<float>(it.velocity)},
+                    {noteSamples, RenderEvent::NoteOff, 0, static_cast<uint16_t>(it.note), 0.f}};
+                job.numSamples = numSamples;
+                job.left = audio.data() + static_cast<size_t>(r) * 2 * numSamples;
+                job.right = job.left + numSamples;
+                job.seed = spec.seed;
+            }
+
+            pool->render(jobs);
+
+            juce::Array<juce::var> items;
+            bool written = true;
+
+            const auto wavFolder = shardFile(shard, "");
+            const auto partialFolder = shardFile(shard, ".partial");
+
+            if (spec.format == Wav)
+            {
+                partialFolder.deleteRecursively();
+                written = partialFolder.createDirectory().wasOk();
+            }
+
+            for (int r = 0; r < rows && written; ++r)
+            {
+                const auto index = first + r;
+                const auto it = itemAt(index);
+                auto &job = jobs[static_cast<size_t>(r)];
+                const auto &patch = spec.patches[static_cast<size_t>(it.patch)];
+
+                auto *o = new juce::DynamicObject();
+                o->setProperty("index", index);
+                o->setProperty("patch", patch.getFullPathName());
+                o->setProperty("name", patch.getFileNameWithoutExtension());
+                o->setProperty("note", it.note);
+                o->setProperty("velocity", it.velocity);
+                o->setProperty("shard", shard);
+
+                if (!job.error.empty())
+                {
+                    // keep the row, silent, so rows and indices still line up
+                    std::fill(job.left, job.left + 2 * numSamples, 0.f);
+                    o->setProperty("error", juce::String(job.error));
+                    ++res.failedItems;
+                }
+
+                if (spec.format == Wav)
+                {
+                    const auto name = juce::String(index).paddedLeft('0', 6) + ".wav";
+
+                    written = writeWav(partialFolder.getChildFile(name), job.left, job.right,
+                                       numSamples, spec.sampleRate);
+                    o->setProperty("file", wavFolder.getFileName() + "/" + name);
+                }
+                else
+                {
+                    o->setProperty("file", shardFile(shard, ".npy").getFileName());
+                    o->setProperty("row", r);
+                }
+
+                items.add(juce::var(o));
+            }
+
+            if (spec.format == Wav)
+            {
+                wavFolder.deleteRecursively();
+                written = written && partialFolder.moveFileTo(wavFolder);
+            }
+            else
+            {
+                written = writeNpy(shardFile(shard, ".npy"), audio.data(), rows, numSamples);
+            }
+
+            // the shard's item list goes last, and only once its audio is in place
+            if (!written || !writeTextAtomically(shardFile(shard, ".json"),
+                                                 juce::JSON::toString(juce::var(items))))
+            {
+                res.error = "Could not write shard " + std::to_string(shard);
+                return res;
+            }
+
+            ++res.renderedShards;
+        }
+
+        if (progress)
+        {
+            progress(res.renderedShards + res.skippedShards, res.shards);
+        }
+    }
+
+    if (res.renderedShards + res.skippedShards == res.shards && !writeManifest())
+    {
+        res.error = "Could not write the manifest";
+    }
+
+    return res;
+}
+
+bool DatasetGenerator::writeManifest() const
+{
+    juce::String lines;
+    const auto numShards = (spec.numItems() + spec.shardSize - 1) / spec.shardSize;
+
+    for (int shard = 0; shard < numShards; ++shard)
+    {
+        const auto items = juce::JSON::parse(shardFile(shard, ".json"));
+
+        if (!items.isArray())
+        {
+            return false;
+        }
+
+        for (const auto &item : *items.getArray())
+        {
+            lines << juce::JSON::toString(item, true) << "\n";
+        }
+    }
+
+    return writeTextAtomically(folder.getChildFile("manifest.jsonl"), lines);
+}
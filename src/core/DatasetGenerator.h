@@ -0,0 +1,115 @@
+/*
+ * OB-Xd was originally written by Vadim Filatov, and then a version
+ * was released under the GPL3 at https://github.com/reales/OB-Xd.
+ * Subsequently, the product was continued by DiscoDSP and the copyright
+ * holders as an excellent closed source product.
+ *
+ * This repository is a successor to OB-Xd version 2.11.
+ * Copyright 2013-2025 by the authors as indicated in the original release,
+ * and subsequent authors as per GitHub transaction log.
+ *
+ * OB-Xf is released under the GNU General Public Licence v3 or later
+ * (GPL-3.0-or-later). The license is found in the file "LICENSE"
+ * in the root of this repository or at:
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * Source code is available at https://github.com/surge-synthesizer/OB-Xf
+ */
+
+
+#ifndef OBXF_SRC_CORE_DATASETGENERATOR_H
+#define OBXF_SRC_CORE_DATASETGENERATOR_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <juce_core/juce_core.h>
+
+/*
+ * Renders every patch × pitch × velocity of a spec as one note, held for noteSeconds
+ * and then released for tailSeconds, into an output folder:
+ *
+ *   spec.json                 the spec, so a resumed run can check it renders the same set
+ *   shard-00000.npy           float32 (n, 2, samples), or with wav a folder of
+ *   shard-00000/000000.wav    32 bit float stereo files, one per item
+ *   shard-00000.json          the items of the shard, written last to mark it complete
+ *   manifest.jsonl            one line per item, gathered from the shards at the end
+ *
+ * Items are numbered patch by patch, then pitch, then velocity, and shard k holds items
+ * [k * shardSize, (k + 1) * shardSize). A shard is rendered in one go on a RenderPool and
+ * written aside before it is moved into place, so an interrupted run leaves only whole
+ * shards behind, and running it again renders just the missing ones.
+ */
+class DatasetGenerator
+{
+  public:
+    enum Format
+    {
+        Npy,
+        Wav
+    };
+
+    struct Spec
+    {
+        std::vector<juce::File> patches;
+
+        int lowestNote{36};
+        int highestNote{84};
+        int noteStep{1};
+        std::vector<int> velocities{127};
+
+        double noteSeconds{1.0};
+        double tailSeconds{1.0};
+        double sampleRate{48000.0};
+
+        int shardSize{128};
+        Format format{Npy};
+        uint32_t seed{0};
+
+        int numItems() const;
+        int numSamples() const;
+        juce::var toVar() const;
+    };
+
+    struct Result
+    {
+        int shards{0};
+        int renderedShards{0};
+        int skippedShards{0};
+        int failedItems{0};
+        std::string error;
+    };
+
+    // called after each shard with the shards done so far and the total
+    using ProgressCallback = std::function<void(int done, int total)>;
+
+    DatasetGenerator(const Spec &spec, const juce::File &outputFolder);
+
+    // numWorkers 0 means one per core; cancel is checked between shards
+    Result run(int numWorkers, const ProgressCallback &progress = {},
+               const std::atomic<bool> *cancel = nullptr);
+
+    // Writes a float32 array of shape (rows, 2, samples) as a .npy file
+    static bool writeNpy(const juce::File &f, const float *data, int rows, int samples);
+
+  private:
+    struct Item
+    {
+        int patch{0};
+        int note{0};
+        int velocity{0};
+    };
+
+    Item itemAt(int index) const;
+    juce::File shardFile(int shard, const juce::String &extension) const;
+    bool writeManifest() const;
+
+    Spec spec;
+    juce::File folder;
+    std::vector<int> notes;
+};
+
+#endif // OBXF_SRC_CORE_DATASETGENERATOR_H
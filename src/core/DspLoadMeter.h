@@ -0,0 +1,123 @@
+/*
+ * OB-Xd was originally written by Vadim Filatov, and then a version
+ * was released under the GPL3 at https://github.com/reales/OB-Xd.
+ * Subsequently, the product was continued by DiscoDSP and the copyright
+ * holders as an excellent closed source product.
+ *
+ * This repository is a successor to OB-Xd version 2.11.
+ * Copyright 2013-2025 by the authors as indicated in the original release,
+ * and subsequent authors as per GitHub transaction log.
+ *
+ * OB-Xf is released under the GNU General Public Licence v3 or later
+ * (GPL-3.0-or-later). The license is found in the file "LICENSE"
+ * in the root of this repository or at:
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * Source code is available at https://github.com/surge-synthesizer/OB-Xf
+ */
+
+#ifndef OBXF_SRC_CORE_DSPLOADMETER_H
+#define OBXF_SRC_CORE_DSPLOADMETER_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <juce_core/juce_core.h>
+
+/*
+ * Measures how much of each block's deadline processBlock used. The audio thread
+ * only writes the latest load into a ring of atomics; readers (editor idle, Python)
+ * copy the ring and do the statistics themselves, so nothing on the audio side
+ * ever waits or sorts.
+ */
+class DspLoadMeter
+{
+  public:
+    static constexpr size_t historySize{512};
+
+    struct Snapshot
+    {
+        // load is block render time divided by block duration, so 1.0 is an xrun
+        float mean{0.f};
+        float p99{0.f};
+        float max{0.f};
+        int blocks{0};
+        int soundingVoices{0};
+        bool highQuality{false};
+    };
+
+    // call at the top of processBlock
+    void beginBlock() { blockStart = juce::Time::getHighResolutionTicks(); }
+
+    // call at the end of processBlock
+    void endBlock(int numSamples, double sampleRate, int soundingVoices, bool highQuality)
+    {
+        if (numSamples <= 0 || sampleRate <= 0.0)
+        {
+            return;
+        }
+
+        const auto elapsed =
+            juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() -
+                                                     blockStart);
+        const auto load = static_cast<float>(elapsed * sampleRate / numSamples);
+        const auto pos = writePos.load(std::memory_order_relaxed);
+
+        history[pos % historySize].store(load, std::memory_order_relaxed);
+        voices.store(soundingVoices, std::memory_order_relaxed);
+        hq.store(highQuality, std::memory_order_relaxed);
+        writePos.store(pos + 1, std::memory_order_release);
+    }
+
+    void reset() { writePos.store(0, std::memory_order_release); }
+
+    Snapshot snapshot() const
+    {
+        Snapshot s;
+        std::array<float, historySize> loads;
+
+        const auto written = writePos.load(std::memory_order_acquire);
+        const auto count = static_cast<size_t>(std::min<uint64_t>(written, historySize));
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            loads[i] = history[i].load(std::memory_order_relaxed);
+        }
+
+        s.blocks = static_cast<int>(count);
+        s.soundingVoices = voices.load(std::memory_order_relaxed);
+        s.highQuality = hq.load(std::memory_order_relaxed);
+
+        if (count == 0)
+        {
+            return s;
+        }
+
+        float sum{0.f};
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            sum += loads[i];
+            s.max = std::max(s.max, loads[i]);
+        }
+
+        s.mean = sum / static_cast<float>(count);
+
+        const auto p99Index = std::min(count - 1, (count * 99) / 100);
+        std::nth_element(loads.begin(), loads.begin() + p99Index, loads.begin() + count);
+        s.p99 = loads[p99Index];
+
+        return s;
+    }
+
+  private:
+    int64_t blockStart{0};
+
+    std::array<std::atomic<float>, historySize> history{};
+    std::atomic<uint64_t> writePos{0};
+    std::atomic<int> voices{0};
+    std::atomic<bool> hq{false};
+};
+
+#endif // OBXF_SRC_CORE_DSPLOADMETER_H
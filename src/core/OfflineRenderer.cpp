@@ -0,0 +1,383 @@
+/*
+ * OB-Xd was originally written by Vadim Filatov, and then a version
+ * was released under the GPL3 at https://github.com/reales/OB-Xd.
+ * Subsequently, the product was continued by DiscoDSP and the copyright
+ * holders as an excellent closed source product.
+ *
+ * This repository is a successor to OB-Xd version 2.11.
+ * Copyright 2013-2025 by the authors as indicated in the original release,
+ * and subsequent authors as per GitHub transaction log.
+ *
+ * OB-Xf is released under the GNU General Public Licence v3 or later
+ * (GPL-3.0-or-later). The license is found in the file "LICENSE"
+ * in the root of this repository or at:
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * Source code is available at https://github.com/surge-synthesizer/OB-Xf
+ */
+
+#include "OfflineRenderer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "ObxfProcessor.h"
+
+float AutomationLane::valueAt(int64_t sample) const
+{
+    const auto x = static_cast<double>(std::max<int64_t>(sample, 0)) / samplesPerPoint;
+    const auto k = static_cast<int64_t>(x);
+
+    if (k >= numPoints - 1)
+    {
+        return points[numPoints - 1];
+    }
+
+    const auto frac = static_cast<float>(x - static_cast<double>(k));
+
+    return points[k] + (points[k + 1] - points[k]) * frac;
+}
+
+OfflineRenderer::OfflineRenderer(ObxfAudioProcessor &p)
+    : processor(p), scratch(2 * maxBlockSize, 0.f),
+      movedParameters(ParameterList.size(), std::numeric_limits<float>::quiet_NaN())
+{
+    midi.ensureSize(4096);
+
+    // there is no message thread to hand RPNs to, so they would never apply
+    processor.getMidiHandler().setApplyRPNImmediately(true);
+}
+
+void OfflineRenderer::prepare(double sampleRate)
+{
+    // processBlock relies on getSampleRate(), which only the host normally sets
+    processor.setRateAndBufferSizeDetails(sampleRate, maxBlockSize);
+    processor.prepareToPlay(sampleRate, maxBlockSize);
+}
+
+bool OfflineRenderer::loadPatch(juce::MemoryBlock &patch)
+{
+    const auto size = static_cast<int>(patch.getSize());
+
+    if (StateManager::isPluginState(patch.getData(), size))
+    {
+        processor.setStateInformation(patch.getData(), size);
+    }
+    else if (!processor.getStateManager().loadFromMemoryBlock(patch))
+    {
+        return false;
+    }
+
+    // the render is the audio thread, so take a queued patch change (and with it a
+    // crossfade of the old voices) before the new values reach the engine
+    processor.getParamCoordinator().getParameterUpdateHandler().updateParameters();
+
+    // otherwise the engine only catches up once processBlock drains the parameter queue
+    const auto &handlers = obxf::getHandlerMap();
+
+    for (const auto &[paramId, value] : processor.getActiveProgram().values)
+    {
+        auto it = handlers.find(paramId.toStdString());
+
+        if (it != handlers.end())
+        {
+            it->second(processor.getSynth(), value.load());
+        }
+    }
+
+    return true;
+}
+
+void OfflineRenderer::setParameters(const std::vector<float> &values)
+{
+    const auto n = std::min(values.size(), movedParameters.size());
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (!std::isnan(values[i]))
+        {
+            applyParameter({0, RenderEvent::Parameter, 0, static_cast<uint16_t>(i), values[i]});
+        }
+    }
+
+    storeParameterValues();
+}
+
+void OfflineRenderer::render(std::vector<RenderEvent> &events, int numSamples, float *left,
+                             float *right)
+{
+    renderSpan(events, {}, numSamples, left, right, nullptr);
+}
+
+void OfflineRenderer::render(std::vector<RenderEvent> &events,
+                             const std::vector<AutomationLane> &lanes, int numSamples, float *left,
+                             float *right)
+{
+    renderSpan(events, lanes, numSamples, left, right, nullptr);
+}
+
+void OfflineRenderer::renderInterleaved(std::vector<RenderEvent> &events, int numSamples,
+                                        float *out)
+{
+    renderSpan(events, {}, numSamples, nullptr, nullptr, out);
+}
+
+void OfflineRenderer::renderSpan(std::vector<RenderEvent> &events,
+                                 const std::vector<AutomationLane> &lanes, int numSamples,
+                                 float *left, float *right, float *interleaved)
+{
+    std::stable_sort(events.begin(), events.end(), [](const auto &a, const auto &b) {
+        const auto ta = std::max<int64_t>(a.time, 0), tb = std::max<int64_t>(b.time, 0);
+
+        if (ta != tb)
+        {
+            return ta < tb;
+        }
+
+        return a.type == RenderEvent::Parameter && b.type != RenderEvent::Parameter;
+    });
+
+    size_t next{0};
+    int pos{0};
+
+    laneValues.assign(lanes.size(), std::numeric_limits<float>::quiet_NaN());
+
+    while (pos < numSamples)
+    {
+        auto end = std::min(numSamples, pos + maxBlockSize);
+
+        midi.clear();
+        bool programChanged{false};
+
+        // everything due now, parameter changes first thanks to the sort
+        for (; next < events.size() && events[next].time <= pos; ++next)
+        {
+            if (events[next].type == RenderEvent::Parameter)
+            {
+                applyParameter(events[next]);
+                forgetLaneValue(lanes, events[next].number);
+            }
+            else
+            {
+                programChanged |= events[next].type == RenderEvent::ProgramChange;
+                addMidiEvent(events[next], 0);
+            }
+        }
+
+        if (!lanes.empty())
+        {
+            applyLanes(lanes, pos);
+
+            // run on until a curve moves, rather than cutting a block every interval
+            auto b = (pos / automationInterval + 1) * automationInterval;
+
+            while (b < end && !lanesMoveAt(lanes, b))
+            {
+                b += automationInterval;
+            }
+
+            end = std::min(end, b);
+        }
+
+        // then MIDI up to the next parameter change, which ends the block early
+        for (; next < events.size() && events[next].time < end; ++next)
+        {
+            if (events[next].type == RenderEvent::Parameter)
+            {
+                end = static_cast<int>(events[next].time);
+                break;
+            }
+
+            programChanged |= events[next].type == RenderEvent::ProgramChange;
+            addMidiEvent(events[next], static_cast<int>(events[next].time) - pos);
+        }
+
+        const auto len = end - pos;
+        float *channels[2] = {interleaved ? scratch.data() : left + pos,
+                              interleaved ? scratch.data() + maxBlockSize : right + pos};
+        juce::AudioBuffer<float> buffer(channels, 2, len);
+
+        processor.processBlock(buffer, midi);
+
+        if (programChanged)
+        {
+            // parameters moved before the program change go to the program first, so the
+            // program's own values land on top of them
+            storeParameterValues();
+            processor.takeAudioThreadHandover();
+        }
+
+        if (interleaved)
+        {
+            auto *out = interleaved + 2 * static_cast<size_t>(pos);
+
+            for (int i = 0; i < len; ++i)
+            {
+                out[2 * i] = channels[0][i];
+                out[2 * i + 1] = channels[1][i];
+            }
+        }
+
+        pos = end;
+    }
+
+    // lags which settled during the render, then the parameters moved since the last
+    // program change
+    processor.takeAudioThreadHandover();
+    storeParameterValues();
+}
+
+bool OfflineRenderer::eventFromMidi(const juce::MidiMessage &m, int64_t time, RenderEvent &e)
+{
+    e.time = time;
+    e.channel = static_cast<uint8_t>(juce::jlimit(1, 16, m.getChannel()) - 1);
+
+    if (m.isNoteOn())
+    {
+        e.type = RenderEvent::NoteOn;
+        e.number = static_cast<uint16_t>(m.getNoteNumber());
+        e.value = m.getVelocity();
+    }
+    else if (m.isNoteOff())
+    {
+        e.type = RenderEvent::NoteOff;
+        e.number = static_cast<uint16_t>(m.getNoteNumber());
+        e.value = m.getVelocity();
+    }
+    else if (m.isController())
+    {
+        e.type = RenderEvent::Controller;
+        e.number = static_cast<uint16_t>(m.getControllerNumber());
+        e.value = static_cast<float>(m.getControllerValue());
+    }
+    else if (m.isPitchWheel())
+    {
+        e.type = RenderEvent::PitchBend;
+        e.number = 0;
+        e.value = (m.getPitchWheelValue() - 8192) / 8192.f;
+    }
+    else if (m.isChannelPressure())
+    {
+        e.type = RenderEvent::ChannelPressure;
+        e.number = 0;
+        e.value = static_cast<float>(m.getChannelPressureValue());
+    }
+    else if (m.isProgramChange())
+    {
+        e.type = RenderEvent::ProgramChange;
+        e.number = static_cast<uint16_t>(m.getProgramChangeNumber());
+        e.value = 0.f;
+    }
+    else
+    {
+        return false;
+    }
+
+    return true;
+}
+
+void OfflineRenderer::addMidiEvent(const RenderEvent &e, int offset)
+{
+    const auto ch = static_cast<int>(e.channel % 16) + 1;
+    const auto seven = [](float v) { return juce::jlimit(0, 127, juce::roundToInt(v)); };
+
+    switch (e.type)
+    {
+    case RenderEvent::NoteOn:
+        midi.addEvent(juce::MidiMessage::noteOn(ch, e.number & 127,
+                                                static_cast<juce::uint8>(seven(e.value))),
+                      offset);
+        break;
+    case RenderEvent::NoteOff:
+        midi.addEvent(juce::MidiMessage::noteOff(ch, e.number & 127,
+                                                 static_cast<juce::uint8>(seven(e.value))),
+                      offset);
+        break;
+    case RenderEvent::Controller:
+        midi.addEvent(juce::MidiMessage::controllerEvent(ch, e.number & 127, seven(e.value)),
+                      offset);
+        break;
+    case RenderEvent::PitchBend:
+        midi.addEvent(juce::MidiMessage::pitchWheel(
+                          ch, juce::jlimit(0, 16383, juce::roundToInt(8192.f + e.value * 8192.f))),
+                      offset);
+        break;
+    case RenderEvent::ChannelPressure:
+        midi.addEvent(juce::MidiMessage::channelPressureChange(ch, seven(e.value)), offset);
+        break;
+    case RenderEvent::ProgramChange:
+        midi.addEvent(juce::MidiMessage::programChange(ch, e.number & 127), offset);
+        break;
+    default:
+        break;
+    }
+}
+
+void OfflineRenderer::applyParameter(const RenderEvent &e)
+{
+    if (e.number >= movedParameters.size())
+    {
+        return;
+    }
+
+    const auto v = juce::jlimit(0.f, 1.f, e.value);
+
+    processor.getParamCoordinator().applyEngineParameterByIndex(e.number, v);
+    movedParameters[e.number] = v;
+}
+
+void OfflineRenderer::applyLanes(const std::vector<AutomationLane> &lanes, int pos)
+{
+    for (size_t i = 0; i < lanes.size(); ++i)
+    {
+        const auto v = lanes[i].valueAt(pos);
+
+        if (v != laneValues[i])
+        {
+            applyParameter({pos, RenderEvent::Parameter, 0, lanes[i].index, v});
+            laneValues[i] = v;
+        }
+    }
+}
+
+void OfflineRenderer::forgetLaneValue(const std::vector<AutomationLane> &lanes, uint16_t index)
+{
+    // the parameter left its curve, so the next applyLanes puts it back even if the curve
+    // itself hasn't moved
+    for (size_t i = 0; i < lanes.size(); ++i)
+    {
+        if (lanes[i].index == index)
+        {
+            laneValues[i] = std::numeric_limits<float>::quiet_NaN();
+        }
+    }
+}
+
+bool OfflineRenderer::lanesMoveAt(const std::vector<AutomationLane> &lanes, int pos) const
+{
+    for (size_t i = 0; i < lanes.size(); ++i)
+    {
+        if (lanes[i].valueAt(pos) != laneValues[i])
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void OfflineRenderer::storeParameterValues()
+{
+    // one program store write per moved parameter, rather than one per event
+    auto &values = processor.getActiveProgram().values;
+
+    for (size_t i = 0; i < movedParameters.size(); ++i)
+    {
+        if (!std::isnan(movedParameters[i]))
+        {
+            values[ParameterList[i].ID] = movedParameters[i];
+            movedParameters[i] = std::numeric_limits<float>::quiet_NaN();
+        }
+    }
+}
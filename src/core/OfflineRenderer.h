@@ -0,0 +1,145 @@
+/*
+ * OB-Xd was originally written by Vadim Filatov, and then a version
+ * was released under the GPL3 at https://github.com/reales/OB-Xd.
+ * Subsequently, the product was continued by DiscoDSP and the copyright
+ * holders as an excellent closed source product.
+ *
+ * This repository is a successor to OB-Xd version 2.11.
+ * Copyright 2013-2025 by the authors as indicated in the original release,
+ * and subsequent authors as per GitHub transaction log.
+ *
+ * OB-Xf is released under the GNU General Public Licence v3 or later
+ * (GPL-3.0-or-later). The license is found in the file "LICENSE"
+ * in the root of this repository or at:
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * Source code is available at https://github.com/surge-synthesizer/OB-Xf
+ */
+
+#ifndef OBXF_SRC_CORE_OFFLINERENDERER_H
+#define OBXF_SRC_CORE_OFFLINERENDERER_H
+
+#include <cstdint>
+#include <vector>
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+class ObxfAudioProcessor;
+
+/*
+ * A timestamped event for OfflineRenderer. MIDI events go through the processor's
+ * MIDI handler exactly as host MIDI would, so MPE (pitch bend, pressure and CC 74 on
+ * member channels) and MIDI learn bindings behave the same as in a DAW.
+ */
+struct RenderEvent
+{
+    enum Type : uint8_t
+    {
+        NoteOn = 0,      // number is the note, value the velocity 0..127
+        NoteOff,         // number is the note, value the release velocity 0..127
+        Controller,      // number is the CC, value 0..127
+        PitchBend,       // value -1..1
+        ChannelPressure, // value 0..127
+        Parameter,       // number is the ParameterList index, value 0..1
+        ProgramChange,   // number is the program, picked from the MIDI Programs folder
+
+        numTypes
+    };
+
+    int64_t time{0}; // in samples from the start of the render
+    uint8_t type{NoteOn};
+    uint8_t channel{0}; // 0 based MIDI channel
+    uint16_t number{0};
+    float value{0.f};
+};
+
+/*
+ * A parameter curve for OfflineRenderer, with points in 0..1. Point k falls on sample
+ * k * samplesPerPoint, with straight lines in between and the last point held, so an
+ * audio rate curve has samplesPerPoint 1 and a control rate curve more.
+ */
+struct AutomationLane
+{
+    uint16_t index{0}; // ParameterList index
+    const float *points{nullptr};
+    int numPoints{0};
+    double samplesPerPoint{1.0};
+
+    float valueAt(int64_t sample) const;
+};
+
+/*
+ * Renders a span of audio with sample accurate events in one call. The span is cut
+ * into blocks at most maxBlockSize long, and also wherever a parameter changes;
+ * MIDI events fall inside the blocks at their exact sample offset. Each block goes
+ * through ObxfAudioProcessor::processBlock, so everything a host render does
+ * (idle block skipping, patch crossfades, DSP load metering) happens here too.
+ *
+ * The renderer doesn't need a message loop: the bend range and MPE configuration
+ * RPNs, which a plugin applies on the message thread, take effect right away, and what
+ * the audio thread hands over to the message thread (settled lags, MIDI program changes)
+ * is taken after each program change and at the end of a render.
+ */
+class OfflineRenderer
+{
+  public:
+    static constexpr int maxBlockSize{512};
+
+    // automation curves are read this often, but blocks are only cut where a curve moves
+    static constexpr int automationInterval{32};
+
+    explicit OfflineRenderer(ObxfAudioProcessor &processor);
+
+    void prepare(double sampleRate);
+
+    // Loads an FXP, OB-Xd patch or plugin state chunk and pushes its values straight
+    // into the engine
+    bool loadPatch(juce::MemoryBlock &patch);
+
+    // Sets parameters from values in ParameterList order; NaN leaves a parameter alone
+    void setParameters(const std::vector<float> &values);
+
+    /*
+     * Sorts the events by time (stably, so events at the same sample keep their order,
+     * except that parameter changes apply before MIDI on that sample) and renders
+     * numSamples into left and right. Events before 0 apply at the start, and events at
+     * or past numSamples are not applied.
+     */
+    void render(std::vector<RenderEvent> &events, int numSamples, float *left, float *right);
+
+    // As render, with the parameters of the lanes following their curves; at the same
+    // sample a curve wins over a parameter event
+    void render(std::vector<RenderEvent> &events, const std::vector<AutomationLane> &lanes,
+                int numSamples, float *left, float *right);
+
+    // As render, but writes numSamples interleaved stereo frames (LRLR...) to out
+    void renderInterleaved(std::vector<RenderEvent> &events, int numSamples, float *out);
+
+    // The RenderEvent for a note, controller, pitch bend, channel pressure or program change
+    static bool eventFromMidi(const juce::MidiMessage &m, int64_t time, RenderEvent &e);
+
+  private:
+    void renderSpan(std::vector<RenderEvent> &events, const std::vector<AutomationLane> &lanes,
+                    int numSamples, float *left, float *right, float *interleaved);
+    void applyLanes(const std::vector<AutomationLane> &lanes, int pos);
+    void forgetLaneValue(const std::vector<AutomationLane> &lanes, uint16_t index);
+    bool lanesMoveAt(const std::vector<AutomationLane> &lanes, int pos) const;
+    void addMidiEvent(const RenderEvent &e, int offset);
+    void applyParameter(const RenderEvent &e);
+    void storeParameterValues();
+
+    ObxfAudioProcessor &processor;
+    juce::MidiBuffer midi;
+
+    // planar block for interleaved renders, processBlock only writes separate channels
+    std::vector<float> scratch;
+
+    // last value each parameter was moved to during a render, NaN if untouched
+    std::vector<float> movedParameters;
+
+    // the value each automation lane was last applied at, NaN once a parameter event
+    // moved its parameter off the curve
+    std::vector<float> laneValues;
+};
+
+#endif // OBXF_SRC_CORE_OFFLINERENDERER_H
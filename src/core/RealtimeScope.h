@@ -0,0 +1,109 @@
+/*
+ * OB-Xd was originally written by Vadim Filatov, and then a version
+ * was released under the GPL3 at https://github.com/reales/OB-Xd.
+ * Subsequently, the product was continued by DiscoDSP and the copyright
+ * holders as an excellent closed source product.
+ *
+ * This repository is a successor to OB-Xd version 2.11.
+ * Copyright 2013-2025 by the authors as indicated in the original release,
+ * and subsequent authors as per GitHub transaction log.
+ *
+ * OB-Xf is released under the GNU General Public Licence v3 or later
+ * (GPL-3.0-or-later). The license is found in the file "LICENSE"
+ * in the root of this repository or at:
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * Source code is available at https://github.com/surge-synthesizer/OB-Xf
+ */
+
+#ifndef OBXF_SRC_CORE_REALTIMESCOPE_H
+#define OBXF_SRC_CORE_REALTIMESCOPE_H
+
+#include <atomic>
+#include <iostream>
+#include <juce_core/juce_core.h>
+
+#if OBXF_RTSAN
+#include <sanitizer/rtsan_interface.h>
+#endif
+
+/*
+ * Marks a region of code (processBlock, basically) as realtime. With ENABLE_RTSAN
+ * the sanitizer runtime traps any allocation, lock or blocking syscall made inside
+ * it and prints a stack trace. In every build the scope is tracked per thread, so
+ * other detectors (like the allocation hooks in obxf-tests) can ask whether they
+ * were called from the audio thread and report through reportViolation().
+ */
+namespace obxf::realtime
+{
+inline int &scopeDepth()
+{
+    static thread_local int depth{0};
+    return depth;
+}
+
+inline std::atomic<int> &violations()
+{
+    static std::atomic<int> count{0};
+    return count;
+}
+
+inline bool inScope() { return scopeDepth() > 0; }
+
+struct Scope
+{
+    Scope()
+    {
+        ++scopeDepth();
+#if OBXF_RTSAN
+        __rtsan_realtime_enter();
+#endif
+    }
+
+    ~Scope()
+    {
+#if OBXF_RTSAN
+        __rtsan_realtime_exit();
+#endif
+        --scopeDepth();
+    }
+
+    JUCE_DECLARE_NON_COPYABLE(Scope)
+};
+
+// Lifts the realtime constraints for a deliberate non-realtime section inside a Scope
+struct Suspend
+{
+    int savedDepth;
+
+    Suspend() : savedDepth(scopeDepth())
+    {
+        scopeDepth() = 0;
+#if OBXF_RTSAN
+        __rtsan_disable();
+#endif
+    }
+
+    ~Suspend()
+    {
+#if OBXF_RTSAN
+        __rtsan_enable();
+#endif
+        scopeDepth() = savedDepth;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE(Suspend)
+};
+
+inline void reportViolation(const char *what)
+{
+    ++violations();
+
+    // reporting allocates, so step out of the scope while we do it
+    Suspend s;
+    std::cerr << "Realtime violation: " << what << "\n"
+              << juce::SystemStats::getStackBacktrace() << std::endl;
+}
+} // namespace obxf::realtime
+
+#endif // OBXF_SRC_CORE_REALTIMESCOPE_H
@@ -0,0 +1,271 @@
+/*
+ * OB-Xd was originally written by Vadim Filatov, and then a version
+ * was released under the GPL3 at https://github.com/reales/OB-Xd.
+ * Subsequently, the product was continued by DiscoDSP and the copyright
+ * holders as an excellent closed source product.
+ *
+ * This repository is a successor to OB-Xd version 2.11.
+ * Copyright 2013-2025 by the authors as indicated in the original release,
+ * and subsequent authors as per GitHub transaction log.
+ *
+ * OB-Xf is released under the GNU General Public Licence v3 or later
+ * (GPL-3.0-or-later). The license is found in the file "LICENSE"
+ * in the root of this repository or at:
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * Source code is available at https://github.com/surge-synthesizer/OB-Xf
+ */
+
+
+#include "RenderCache.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "BuildIdentity.h"
+#include "ObxfProcessor.h"
+#include "SharedResources.h"
+
+namespace
+{
+// Two FNV-1a chains over the same bytes from different offset bases, see RenderCache::Key
+struct KeyHasher
+{
+    RenderCache::Key key{14695981039346656037ull, 0x6a09e667f3bcc908ull};
+
+    void add(const void *data, size_t size)
+    {
+        key.name = obxf::SharedResources::hashContents(data, size, key.name);
+        key.digest = obxf::SharedResources::hashContents(data, size, key.digest);
+    }
+
+    template <typename T> void add(const T &v) { add(&v, sizeof(v)); }
+};
+} // namespace
+
+RenderCache::RenderCache(const juce::File &f, int64_t mb) : folder(f), maxBytes(mb)
+{
+    folder.createDirectory();
+
+    for (const auto &file : folder.findChildFiles(juce::File::findFiles, false, "*.f32"))
+    {
+        const auto key = static_cast<uint64_t>(
+            file.getFileNameWithoutExtension().getHexValue64());
+
+        entries[key] = {file.getSize(), file.getLastModificationTime().toMilliseconds()};
+        totalBytes += file.getSize();
+    }
+
+    evict();
+}
+
+RenderCache::Key RenderCache::keyFor(const ObxfAudioProcessor &processor,
+                                     const std::vector<RenderEvent> &events, int numSamples,
+                                     double sampleRate)
+{
+    KeyHasher h;
+
+    // renders are only bit exact on the same sources, see cmake/build_identity.cmake
+    static constexpr char build[] = OBXF_BUILD_IDENTITY;
+    h.add(magic, sizeof(magic));
+    h.add(build, sizeof(build) - 1);
+
+    h.add(version);
+    h.add(numSamples);
+    h.add(sampleRate);
+
+    const auto &values = processor.getActiveProgram().values;
+
+    for (const auto &param : ParameterList)
+    {
+        const auto it = values.find(param.ID);
+        h.add(it != values.end() ? it->second.load() : 0.f);
+    }
+
+    const auto &synth = processor.getSynth();
+    const auto *mb = synth.getMotherboard();
+
+    for (const auto &row : mb->voiceMatrix.rows)
+    {
+        h.add(row.source);
+        h.add(row.target);
+        h.add(row.depth);
+    }
+
+    // controllers in the events land on whichever parameters they are bound to
+    for (auto c : processor.getMidiMap().controllers)
+    {
+        h.add(c);
+    }
+
+    // the quality actually running, which a locked HQ mode may have overridden
+    h.add(mb->oversample);
+    h.add(mb->mpeEnabled);
+    h.add(mb->mpePitchBendRange);
+    h.add(synth.getSeed());
+
+    for (const auto &e : events)
+    {
+        h.add(e.time);
+        h.add(e.type);
+        h.add(e.channel);
+        h.add(e.number);
+        h.add(e.value);
+    }
+
+    return h.key;
+}
+
+juce::File RenderCache::fileFor(uint64_t key) const
+{
+    return folder.getChildFile(juce::String::toHexString(static_cast<juce::int64>(key)) + ".f32");
+}
+
+bool RenderCache::fetch(const Key &key, int numSamples, float *left, float *right)
+{
+    const auto file = fileFor(key.name);
+    const auto bytes = static_cast<size_t>(numSamples) * sizeof(float);
+    int64_t size{0};
+
+    {
+        juce::MemoryMappedFile mapped(file, juce::MemoryMappedFile::readOnly);
+
+        if (mapped.getData() == nullptr || mapped.getSize() != headerSize + 2 * bytes ||
+            std::memcmp(mapped.getData(), magic, sizeof(magic)) != 0)
+        {
+            return false;
+        }
+
+        juce::MemoryInputStream in(mapped.getData(), headerSize, false);
+        in.skipNextBytes(sizeof(magic));
+
+        if (in.readInt() != version || in.readInt() != numSamples ||
+            static_cast<uint64_t>(in.readInt64()) != key.digest)
+        {
+            return false;
+        }
+
+        const auto *audio = static_cast<const char *>(mapped.getData()) + headerSize;
+
+        std::memcpy(left, audio, bytes);
+        std::memcpy(right, audio + bytes, bytes);
+
+        size = static_cast<int64_t>(mapped.getSize());
+    }
+
+    file.setLastModificationTime(juce::Time::getCurrentTime());
+    touch(key.name, size);
+
+    return true;
+}
+
+void RenderCache::store(const Key &key, int numSamples, const float *left, const float *right)
+{
+    const auto file = fileFor(key.name);
+    const auto bytes = static_cast<size_t>(numSamples) * sizeof(float);
+
+    {
+        // Write aside and move into place, so nobody ever maps a half written file
+        juce::TemporaryFile temp(file);
+
+        {
+            juce::FileOutputStream out(temp.getFile());
+
+            if (!out.openedOk())
+            {
+                return;
+            }
+
+            out.write(magic, sizeof(magic));
+            out.writeInt(version);
+            out.writeInt(numSamples);
+            out.writeInt64(static_cast<juce::int64>(key.digest));
+            out.write(left, bytes);
+            out.write(right, bytes);
+            out.flush();
+
+            if (out.getStatus().failed())
+            {
+                return;
+            }
+        }
+
+        if (!temp.overwriteTargetFileWithTemporary())
+        {
+            return;
+        }
+    }
+
+    touch(key.name, static_cast<int64_t>(headerSize + 2 * bytes));
+    evict();
+}
+
+void RenderCache::touch(uint64_t key, int64_t size)
+{
+    std::lock_guard<std::mutex> g(lock);
+
+    auto &e = entries[key];
+    totalBytes += size - e.size;
+    e.size = size;
+    e.lastUse = juce::Time::currentTimeMillis();
+}
+
+void RenderCache::evict()
+{
+    std::vector<uint64_t> victims;
+
+    {
+        std::lock_guard<std::mutex> g(lock);
+
+        if (totalBytes <= maxBytes)
+        {
+            return;
+        }
+
+        std::vector<std::pair<int64_t, uint64_t>> byAge;
+        byAge.reserve(entries.size());
+
+        for (const auto &[key, e] : entries)
+        {
+            byAge.emplace_back(e.lastUse, key);
+        }
+
+        std::sort(byAge.begin(), byAge.end());
+
+        for (const auto &[lastUse, key] : byAge)
+        {
+            if (totalBytes <= maxBytes)
+            {
+                break;
+            }
+
+            totalBytes -= entries[key].size;
+            entries.erase(key);
+            victims.push_back(key);
+        }
+    }
+
+    for (auto key : victims)
+    {
+        fileFor(key).deleteFile();
+    }
+}
+
+int64_t RenderCache::getSizeInBytes() const
+{
+    std::lock_guard<std::mutex> g(lock);
+    return totalBytes;
+}
+
+void RenderCache::clear()
+{
+    std::lock_guard<std::mutex> g(lock);
+
+    for (const auto &[key, e] : entries)
+    {
+        fileFor(key).deleteFile();
+    }
+
+    entries.clear();
+    totalBytes = 0;
+}
@@ -0,0 +1,95 @@
+/*
+ * OB-Xd was originally written by Vadim Filatov, and then a version
+ * was released under the GPL3 at https://github.com/reales/OB-Xd.
+ * Subsequently, the product was continued by DiscoDSP and the copyright
+ * holders as an excellent closed source product.
+ *
+ * This repository is a successor to OB-Xd version 2.11.
+ * Copyright 2013-2025 by the authors as indicated in the original release,
+ * and subsequent authors as per GitHub transaction log.
+ *
+ * OB-Xf is released under the GNU General Public Licence v3 or later
+ * (GPL-3.0-or-later). The license is found in the file "LICENSE"
+ * in the root of this repository or at:
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * Source code is available at https://github.com/surge-synthesizer/OB-Xf
+ */
+
+
+#ifndef OBXF_SRC_CORE_RENDERCACHE_H
+#define OBXF_SRC_CORE_RENDERCACHE_H
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <juce_core/juce_core.h>
+
+#include "OfflineRenderer.h"
+
+class ObxfAudioProcessor;
+
+/*
+ * A content addressed store of finished renders. With the engine seeded, a render from
+ * silence is a pure function of the engine's parameters, matrix, MIDI bindings, seed and
+ * quality, the events, the length and the sample rate; keyFor hashes all of those (and
+ * the build, as renders are only bit exact on the same build) into a key.
+ *
+ * A key is two independent 64 bit hashes: one names the file, the other is kept in its
+ * header and has to match as well, so a collision of the name alone never hands back
+ * another render.
+ *
+ * Each render is a file of planar float32 audio, mapped to read it back. Files are
+ * touched on every hit, and once the store outgrows maxBytes the least recently used
+ * ones are deleted. Files are written aside and moved into place, so several pools or
+ * processes can share one folder.
+ */
+class RenderCache
+{
+  public:
+    RenderCache(const juce::File &folder, int64_t maxBytes);
+
+    struct Key
+    {
+        uint64_t name{0};
+        uint64_t digest{0};
+    };
+
+    static Key keyFor(const ObxfAudioProcessor &processor, const std::vector<RenderEvent> &events,
+                      int numSamples, double sampleRate);
+
+    // Copies a cached render into left and right; false if there is none
+    bool fetch(const Key &key, int numSamples, float *left, float *right);
+    void store(const Key &key, int numSamples, const float *left, const float *right);
+
+    int64_t getSizeInBytes() const;
+    int64_t getMaxBytes() const { return maxBytes; }
+
+    void clear();
+
+  private:
+    static constexpr char magic[4] = {'O', 'B', 'X', 'A'};
+    static constexpr int version{2};
+    static constexpr size_t headerSize{sizeof(magic) + 16};
+
+    struct Entry
+    {
+        int64_t size{0};
+        int64_t lastUse{0};
+    };
+
+    juce::File fileFor(uint64_t key) const;
+    void touch(uint64_t key, int64_t size);
+    void evict();
+
+    juce::File folder;
+    int64_t maxBytes{0};
+
+    mutable std::mutex lock;
+    std::unordered_map<uint64_t, Entry> entries;
+    int64_t totalBytes{0};
+};
+
+#endif // OBXF_SRC_CORE_RENDERCACHE_H
@@ -0,0 +1,186 @@
+/*
+ * OB-Xd was originally written by Vadim Filatov, and then a version
+ * was released under the GPL3 at https://github.com/reales/OB-Xd.
+ * Subsequently, the product was continued by DiscoDSP and the copyright
+ * holders as an excellent closed source product.
+ *
+ * This repository is a successor to OB-Xd version 2.11.
+ * Copyright 2013-2025 by the authors as indicated in the original release,
+ * and subsequent authors as per GitHub transaction log.
+ *
+ * OB-Xf is released under the GNU General Public Licence v3 or later
+ * (GPL-3.0-or-later). The license is found in the file "LICENSE"
+ * in the root of this repository or at:
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * Source code is available at https://github.com/surge-synthesizer/OB-Xf
+ */
+
+#include "RenderPool.h"
+
+#include "ObxfProcessor.h"
+#include "RenderCache.h"
+
+RenderPool::RenderPool(int numWorkers, double sr) : sampleRate(sr)
+{
+    if (numWorkers <= 0)
+    {
+        numWorkers = juce::jmax(1, juce::SystemStats::getNumCpus());
+    }
+
+    initValues.reserve(ParameterList.size());
+
+    for (const auto &param : ParameterList)
+    {
+        initValues.push_back(param.meta.naturalToNormalized01(param.meta.defaultVal));
+    }
+
+    // The engines are built here, on the calling thread, just like a single engine would be
+    for (int i = 0; i < numWorkers; ++i)
+    {
+        auto w = std::make_unique<Worker>();
+        w->processor = std::make_unique<ObxfAudioProcessor>();
+        w->renderer = std::make_unique<OfflineRenderer>(*w->processor);
+        w->renderer->prepare(sampleRate);
+
+        // every job starts out from this, so it renders the same whichever worker draws it
+        const auto &synth = w->processor->getSynth();
+        w->pristine.resize(synth.getSnapshotSize());
+        synth.snapshot(w->pristine.data());
+
+        workers.push_back(std::move(w));
+    }
+
+    for (auto &w : workers)
+    {
+        w->thread = std::thread([this, wp = w.get()]() { run(*wp); });
+    }
+}
+
+RenderPool::~RenderPool()
+{
+    {
+        std::lock_guard<std::mutex> g(lock);
+        quit = true;
+    }
+
+    wake.notify_all();
+
+    for (auto &w : workers)
+    {
+        w->thread.join();
+    }
+}
+
+void RenderPool::render(std::vector<Job> &jobs)
+{
+    std::unique_lock<std::mutex> g(lock);
+
+    batch = &jobs;
+    nextJob.store(0);
+    busyWorkers = getNumWorkers();
+    ++generation;
+
+    wake.notify_all();
+    finished.wait(g, [this]() { return busyWorkers == 0; });
+
+    batch = nullptr;
+}
+
+void RenderPool::run(Worker &w)
+{
+    uint64_t seen{0};
+
+    for (;;)
+    {
+        std::vector<Job> *jobs;
+
+        {
+            std::unique_lock<std::mutex> g(lock);
+            wake.wait(g, [&]() { return quit || generation != seen; });
+
+            if (quit)
+            {
+                return;
+            }
+
+            seen = generation;
+            jobs = batch;
+        }
+
+        for (auto i = nextJob.fetch_add(1); i < jobs->size(); i = nextJob.fetch_add(1))
+        {
+            renderJob(w, (*jobs)[i]);
+        }
+
+        {
+            std::lock_guard<std::mutex> g(lock);
+            --busyWorkers;
+        }
+
+        finished.notify_all();
+    }
+}
+
+void RenderPool::renderJob(Worker &w, Job &job)
+{
+    job.error.clear();
+    job.cached = false;
+
+    if (job.numSamples < 0 || (job.numSamples > 0 && (!job.left || !job.right)))
+    {
+        job.error = "No output buffer";
+        return;
+    }
+
+    /*
+     * Start every job from the engine as it was when the worker was built: not just silent,
+     * but with LFO phases, smoothers and the voice allocator back where they started, so a
+     * job never hears anything of the one before it.
+     */
+    w.renderer->prepare(sampleRate);
+    w.processor->getSynth().restore(w.pristine.data(), w.pristine.size());
+
+    auto &midiHandler = w.processor->getMidiHandler();
+    const auto *mb = w.processor->getSynth().getMotherboard();
+
+    midiHandler.mpeEnabled.store(mb->mpeEnabled);
+    midiHandler.mpePitchBendRange.store(mb->mpePitchBendRange);
+
+    if (job.patch != juce::File())
+    {
+        juce::MemoryBlock mb;
+
+        if (!job.patch.loadFileAsData(mb) || !w.renderer->loadPatch(mb))
+        {
+            job.error = "Could not load patch " + job.patch.getFullPathName().toStdString();
+            return;
+        }
+    }
+    else
+    {
+        w.processor->getSynth().getMotherboard()->voiceMatrix.fromElement(nullptr);
+        w.renderer->setParameters(initValues);
+    }
+
+    w.renderer->setParameters(job.parameters);
+    w.processor->setRenderSeed(job.seed);
+
+    if (!cache)
+    {
+        w.renderer->render(job.events, job.numSamples, job.left, job.right);
+        return;
+    }
+
+    // the engine is set up now, so the key covers the patch as loaded
+    const auto key = RenderCache::keyFor(*w.processor, job.events, job.numSamples, sampleRate);
+
+    if (cache->fetch(key, job.numSamples, job.left, job.right))
+    {
+        job.cached = true;
+        return;
+    }
+
+    w.renderer->render(job.events, job.numSamples, job.left, job.right);
+    cache->store(key, job.numSamples, job.left, job.right);
+}
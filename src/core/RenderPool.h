@@ -0,0 +1,110 @@
+/*
+ * OB-Xd was originally written by Vadim Filatov, and then a version
+ * was released under the GPL3 at https://github.com/reales/OB-Xd.
+ * Subsequently, the product was continued by DiscoDSP and the copyright
+ * holders as an excellent closed source product.
+ *
+ * This repository is a successor to OB-Xd version 2.11.
+ * Copyright 2013-2025 by the authors as indicated in the original release,
+ * and subsequent authors as per GitHub transaction log.
+ *
+ * OB-Xf is released under the GNU General Public Licence v3 or later
+ * (GPL-3.0-or-later). The license is found in the file "LICENSE"
+ * in the root of this repository or at:
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * Source code is available at https://github.com/surge-synthesizer/OB-Xf
+ */
+
+#ifndef OBXF_SRC_CORE_RENDERPOOL_H
+#define OBXF_SRC_CORE_RENDERPOOL_H
+
+#include <atomic>
+#include <cstdint>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <juce_core/juce_core.h>
+
+#include "OfflineRenderer.h"
+
+class ObxfAudioProcessor;
+class RenderCache;
+
+/*
+ * A fixed set of independent engines, each owned by its own thread, for rendering
+ * large batches of short renders. Jobs are handed out one at a time from a shared
+ * counter, so a worker which drew short jobs simply takes more of them.
+ */
+class RenderPool
+{
+  public:
+    struct Job
+    {
+        // loaded first if set, otherwise the job starts from the init patch
+        juce::File patch;
+        // then applied in ParameterList order, NaN leaves a parameter as the patch has it
+        std::vector<float> parameters;
+        // sorted in place by the render
+        std::vector<RenderEvent> events;
+        // the engine seed, so a job renders the same on any worker; see Motherboard::setSeed
+        uint32_t seed{0};
+
+        int numSamples{0};
+        float *left{nullptr};
+        float *right{nullptr};
+
+        // set when the job could not be rendered
+        std::string error;
+        // set when the audio came from the cache rather than a render
+        bool cached{false};
+    };
+
+    // numWorkers 0 means one per core
+    RenderPool(int numWorkers, double sampleRate);
+    ~RenderPool();
+
+    int getNumWorkers() const { return static_cast<int>(workers.size()); }
+    double getSampleRate() const { return sampleRate; }
+
+    // Renders every job and returns once all of them are done
+    void render(std::vector<Job> &jobs);
+
+    // With a cache, jobs rendered before are read back from it instead of rendered; not
+    // owned, and only to be changed between renders
+    void setCache(RenderCache *c) { cache = c; }
+
+  private:
+    struct Worker
+    {
+        std::unique_ptr<ObxfAudioProcessor> processor;
+        std::unique_ptr<OfflineRenderer> renderer;
+        // the engine right after prepare; see SynthEngine::snapshot
+        std::vector<uint8_t> pristine;
+        std::thread thread;
+    };
+
+    void run(Worker &w);
+    void renderJob(Worker &w, Job &job);
+
+    double sampleRate;
+    std::vector<std::unique_ptr<Worker>> workers;
+    RenderCache *cache{nullptr};
+
+    // the init patch, for jobs which don't load one
+    std::vector<float> initValues;
+
+    std::mutex lock;
+    std::condition_variable wake, finished;
+    std::vector<Job> *batch{nullptr};
+    std::atomic<size_t> nextJob{0};
+    uint64_t generation{0};
+    int busyWorkers{0};
+    bool quit{false};
+};
+
+#endif // OBXF_SRC_CORE_RENDERPOOL_H
@@ -73,7 +73,7 @@ struct PanelGroup
     Panel *findPanel(const std::string &selectorName);
 };
 
-// Cached per-widget layout entry, populated once from XML, reused in resized()
+// Cached per-widget layout entry, populated once from the compiled theme, reused in resized()
 struct WidgetLayout
 {
     juce::String name;
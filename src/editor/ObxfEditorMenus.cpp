@@ -20,6 +20,7 @@
 
 #include "gui/AboutScreen.h"
 #include "gui/MutatorMenu.h"
+#include "gui/PatchBrowser.h"
 #include "gui/SaveDialog.h"
 
 #include "gui/FocusDebugger.h"
@@ -397,6 +398,12 @@ void ObxfAudioProcessorEditor::createMenu()
         menu->addSubMenu("Zoom", sizeMenu);
     }
 
+    menu->addItem(toOSCase("Show DSP Load"), true, dspLoadLabel && dspLoadLabel->isVisible(),
+                  [w = SafePointer(this)]() {
+                      if (w)
+                          w->toggleDspLoadDisplay();
+                  });
+
 #if (defined(DEBUG) || defined(_DEBUG)) && !JUCE_IOS
     juce::PopupMenu debugMenu;
 
@@ -636,14 +643,21 @@ void ObxfAudioProcessorEditor::MenuActionCallback(int action)
     if (action == MenuAction::ImportObxdBank)
     {
         fileChooser =
-            std::make_unique<juce::FileChooser>("Import OB-Xd Bank", juce::File(), "*.fxb", true);
+            std::make_unique<juce::FileChooser>("Import OB-Xd Banks", juce::File(), "*.fxb", true);
+
+        fileChooser->launchAsync(juce::FileBrowserComponent::openMode |
+                                     juce::FileBrowserComponent::canSelectFiles |
+                                     juce::FileBrowserComponent::canSelectMultipleItems,
+                                 [this](const juce::FileChooser &chooser) {
+                                     if (const auto results = chooser.getResults();
+                                         !results.isEmpty())
+                                         importObxdBanks(results);
+                                 });
+    }
 
-        fileChooser->launchAsync(
-            juce::FileBrowserComponent::openMode | juce::FileBrowserComponent::canSelectFiles,
-            [this](const juce::FileChooser &chooser) {
-                if (const juce::File result = chooser.getResult(); result != juce::File())
-                    importObxdBank(result);
-            });
+    if (action == MenuAction::SearchPatches)
+    {
+        showPatchBrowser(true);
     }
 
 #if (defined(DEBUG) || defined(_DEBUG)) && !JUCE_IOS
@@ -678,123 +692,131 @@ void ObxfAudioProcessorEditor::keyboardFocusMainMenu()
     }
 }
 
-void ObxfAudioProcessorEditor::importObxdBank(const juce::File &fxbFile)
+namespace
 {
-    juce::MemoryBlock fileData;
-    if (!fxbFile.loadFileAsData(fileData))
+
+// Runs a bank import with a progress window and cancel button, then hands the result
+// back on the message thread. Deletes itself once done.
+class ObxdBankImportThread final : public juce::ThreadWithProgressWindow
+{
+  public:
+    using callback_t = std::function<void(const ObxdImporter::BankImportResult &)>;
+
+    ObxdBankImportThread(const juce::Array<juce::File> &files, const juce::File &dest,
+                         callback_t done, juce::Component *parent)
+        : juce::ThreadWithProgressWindow("Importing OB-Xd Banks", true, true, 10000, "Cancel",
+                                         parent),
+          fxbFiles(files.begin(), files.end()), destFolder(dest), onDone(std::move(done))
     {
-        juce::AlertWindow::showMessageBoxAsync(juce::AlertWindow::WarningIcon, "OB-Xd Bank Import",
-                                               "Could not read the selected file!");
-        return;
     }
 
-    if (!ObxdImporter::isOBXdData(fileData.getData(), fileData.getSize()))
+    void run() override
     {
-        juce::AlertWindow::showMessageBoxAsync(
-            juce::AlertWindow::WarningIcon, "OB-Xd Bank Import",
-            "The selected file does not appear to be a valid OB-Xd bank!");
-        return;
-    }
+        ObxdImporter::BankImportOptions options;
 
-    const juce::String bankName = fxbFile.getFileNameWithoutExtension();
-    const juce::File destFolder = utils.getUserPatchFolder();
+        options.progress = [this](const ObxdImporter::BankImportProgress &p) {
+            setProgress(p.fraction());
+            setStatusMessage(juce::String(p.patchesWritten) + " patches from " +
+                             juce::String(p.banksRead) + " of " + juce::String(p.banksTotal) +
+                             " banks");
+        };
+        options.shouldCancel = [this]() { return threadShouldExit(); };
 
-    const auto result = ObxdImporter::importBankFromFxb(
-        fileData.getData(), fileData.getSize(), bankName, destFolder,
-        [this](const Program &prog, juce::MemoryBlock &mb) {
-            return utils.serializeProgramToMemoryBlock(prog, mb);
-        });
+        result = ObxdImporter::importBanks(fxbFiles, destFolder,
+                                           &Utils::serializeProgramToMemoryBlock, options);
+    }
 
-    if (result.parseError)
+    void threadComplete(bool /*userPressedCancel*/) override
     {
-        juce::AlertWindow::showMessageBoxAsync(
-            juce::AlertWindow::WarningIcon, "OB-Xd Bank Import",
-            "The file could not be parsed as a valid OB-Xd bank!");
-        return;
+        if (onDone)
+        {
+            onDone(result);
+        }
+
+        delete this;
     }
 
-    utils.rescanPatchTree();
+  private:
+    std::vector<juce::File> fxbFiles;
+    juce::File destFolder;
+    callback_t onDone;
+    ObxdImporter::BankImportResult result;
+};
 
-    const auto pn = processor.getActiveProgram().getName().toStdString();
+} // namespace
 
-    processor.resetLastLoadedProgramByName(pn);
+void ObxfAudioProcessorEditor::importObxdBanks(const juce::Array<juce::File> &fxbFiles)
+{
+    const juce::String bankName =
+        fxbFiles.size() == 1 ? "\"" + fxbFiles[0].getFileNameWithoutExtension() + "\""
+                             : juce::String(fxbFiles.size()) + " banks";
+
+    auto onDone = [bankName, numBanks = fxbFiles.size(),
+                   safeThis = juce::Component::SafePointer(this)](
+                      const ObxdImporter::BankImportResult &result) {
+        if (!safeThis)
+        {
+            return;
+        }
 
-    juce::String msg;
-    if (result.imported == 0)
-    {
-        msg = "No patches were imported from \"" + bankName + "\".";
-    }
-    else
-    {
-        msg = juce::String(result.imported) + " patch" + (result.imported == 1 ? "" : "es") +
-              " imported from \"" + bankName + "\".";
-    }
+        if (result.failedBanks == numBanks)
+        {
+            juce::AlertWindow::showMessageBoxAsync(
+                juce::AlertWindow::WarningIcon, "OB-Xd Bank Import",
+                numBanks == 1 ? "The file could not be parsed as a valid OB-Xd bank!"
+                              : "None of the files could be parsed as valid OB-Xd banks!");
+            return;
+        }
 
-    if (result.skipped > 0)
-    {
-        msg += "\n" + juce::String(result.skipped) + " init patch" +
-               (result.skipped == 1 ? " was" : "es were") + " skipped.";
-    }
+        safeThis->utils.rescanPatchTree();
 
-    juce::AlertWindow::showMessageBoxAsync(juce::AlertWindow::InfoIcon, "OB-Xd Bank Import", msg);
-}
+        const auto pn = safeThis->processor.getActiveProgram().getName().toStdString();
 
-// Patch list
+        safeThis->processor.resetLastLoadedProgramByName(pn);
 
-juce::PopupMenu ObxfAudioProcessorEditor::createPatchList(juce::PopupMenu &menu) const
-{
-    auto lsi = processor.lastLoadedProgram;
+        juce::String msg;
+        if (result.imported == 0)
+        {
+            msg = "No patches were imported from " + bankName + ".";
+        }
+        else
+        {
+            msg = juce::String(result.imported) + " patch" + (result.imported == 1 ? "" : "es") +
+                  " imported from " + bankName + ".";
+        }
 
-    auto raddTo = [that = this, lsi](juce::PopupMenu &m, const Utils::PatchTreeNode::ptr_t &node,
-                                     auto &&self) -> void {
-        for (auto &child : node->children)
+        if (result.skipped > 0)
         {
-            auto checked = lsi >= child->childRange.first && lsi <= child->childRange.second;
-            if (child->isFolder)
-            {
-                if (!child->children.empty())
-                {
-                    juce::PopupMenu subMenu;
-                    self(subMenu, child, self);
-                    m.addSubMenu(child->displayName, subMenu, true, juce::Image(), checked);
-                }
-            }
-            else
-            {
-                m.addItem(child->displayName, true, checked,
-                          [ch = std::weak_ptr(child), w = that]() {
-                              if (auto sp = ch.lock())
-                              {
-                                  w->utils.loadPatch(sp);
-                              }
-                          });
-            }
+            msg += "\n" + juce::String(result.skipped) + " init patch" +
+                   (result.skipped == 1 ? " was" : "es were") + " skipped.";
         }
-    };
 
-    for (auto i = 0U; i < utils.patchRoot->children.size(); i++)
-    {
-        auto &ch = utils.patchRoot->children[i];
+        if (result.failedBanks > 0)
+        {
+            msg += "\n" + juce::String(result.failedBanks) +
+                   (result.failedBanks == 1 ? " file was not a valid OB-Xd bank."
+                                            : " files were not valid OB-Xd banks.");
+        }
 
-        if (!ch->children.empty())
+        if (result.cancelled)
         {
-            menu.addSectionHeader(Utils::toString(ch->locationType));
-            menu.addSeparator();
+            msg += "\nThe import was cancelled.";
+        }
 
-            raddTo(menu, ch, raddTo);
+        juce::AlertWindow::showMessageBoxAsync(juce::AlertWindow::InfoIcon, "OB-Xd Bank Import",
+                                               msg);
+    };
 
-            if (i < utils.patchRoot->children.size() - 1)
-            {
-                menu.addColumnBreak();
-            }
-        }
-    }
+    auto *job =
+        new ObxdBankImportThread(fxbFiles, utils.getUserPatchFolder(), std::move(onDone), this);
+    job->launchThread();
+}
 
-    using namespace sst::plugininfra::misc_platform;
+// Patch list
 
-    menu.addColumnBreak();
-    menu.addSectionHeader("Functions");
-    menu.addSeparator();
+void ObxfAudioProcessorEditor::addPatchFunctions(juce::PopupMenu &menu) const
+{
+    using namespace sst::plugininfra::misc_platform;
 
     bool enablePasteOption = utils.isPatchInClipboard();
 
@@ -811,6 +833,7 @@ juce::PopupMenu ObxfAudioProcessorEditor::createPatchList(juce::PopupMenu &menu)
 #endif
                  true, false);
     menu.addItem(MenuAction::SavePatch, toOSCase("Save Patch..."), true, false);
+    menu.addItem(MenuAction::SearchPatches, toOSCase("Search Patches..."), true, false);
 
     menu.addSeparator();
 
@@ -831,9 +854,12 @@ juce::PopupMenu ObxfAudioProcessorEditor::createPatchList(juce::PopupMenu &menu)
     /*     menu.addItem(MenuAction::SetDefaultPatch, toOSCase("Set Current Patch as Default"), true,
                      false); */
 
-    menu.addItem(MenuAction::RefreshBrowser, toOSCase("Refresh Patch Browser"), true, false);
+    menu.addItem(toOSCase("Crossfade Patch Changes"), true, processor.patchCrossfade.load(),
+                 [p = &processor]() { p->patchCrossfade.store(!p->patchCrossfade.load()); });
+
+    menu.addSeparator();
 
-    return menu;
+    menu.addItem(MenuAction::RefreshBrowser, toOSCase("Refresh Patch Browser"), true, false);
 }
 
 int ObxfAudioProcessorEditor::patchesInCurrentFolder() const
@@ -853,6 +879,14 @@ int ObxfAudioProcessorEditor::patchesInCurrentFolder() const
     return 0;
 }
 
+void ObxfAudioProcessorEditor::showPatchBrowser(bool focusFilter)
+{
+    if (patchBrowser)
+    {
+        patchBrowser->showOver(this, focusFilter);
+    }
+}
+
 // Mutator
 void ObxfAudioProcessorEditor::showMutatorMenu()
 {
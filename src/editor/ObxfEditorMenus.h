@@ -77,11 +77,12 @@ void createMidiMapMenu(int menuNo, juce::PopupMenu &menuMidi);
 void resultFromMenu(juce::Point<int> pos);
 void MenuActionCallback(int action);
 void keyboardFocusMainMenu();
-void importObxdBank(const juce::File &fxbFile);
+void importObxdBanks(const juce::Array<juce::File> &fxbFiles);
 
 // Patch list
-juce::PopupMenu createPatchList(juce::PopupMenu &menu) const;
+void addPatchFunctions(juce::PopupMenu &menu) const;
 int patchesInCurrentFolder() const;
+void showPatchBrowser(bool focusFilter = false);
 
 // Mutator
 void showMutatorMenu();
@@ -19,10 +19,11 @@
 #include "../ObxfEditor.h"
 
 #include "gui/AboutScreen.h"
+#include "gui/PatchBrowser.h"
 #include "gui/SaveDialog.h"
 
 // Theme lifecycle
-void ObxfAudioProcessorEditor::loadTheme(ObxfAudioProcessor &ownerFilter)
+void ObxfAudioProcessorEditor::loadTheme(ObxfAudioProcessor &ownerFilter, bool reload)
 {
     skinLoaded = false;
 
@@ -32,30 +33,21 @@ void ObxfAudioProcessorEditor::loadTheme(ObxfAudioProcessor &ownerFilter)
     const auto parameterValues = saveComponentParameterValues();
     clearAndResetComponents(ownerFilter);
 
-    if (themeLocation.locationType == Utils::EMBEDDED)
-    {
-        auto xml = juce::String(BinaryData::theme_xml, BinaryData::theme_xmlSize);
-        cachedThemeXml = juce::XmlDocument(xml).getDocumentElement();
-    }
-    else
-    {
-        const juce::File theme = themeLocation.file.getChildFile("theme.xml");
-        cachedThemeXml = juce::XmlDocument(theme).getDocumentElement();
-    }
+    const bool embedded = themeLocation.locationType == Utils::EMBEDDED;
+
+    cachedThemeLayout = loadThemeLayout(themeLocation);
 
-    if (!cachedThemeXml)
+    if (!cachedThemeLayout)
     {
         jassertfalse;
         return;
     }
 
-    if (cachedThemeXml->getTagName() == "obxf-theme")
+    if (cachedThemeLayout->isTheme)
     {
-        imageCache.clearCache();
-        imageCache.embeddedMode = (themeLocation.locationType == Utils::EMBEDDED);
-        imageCache.skinDir = imageCache.embeddedMode ? juce::File() : themeLocation.file;
+        imageCache.setTheme(embedded, themeLocation.file, reload);
 
-        createComponentsFromXml(cachedThemeXml.get());
+        createComponentsFromLayout(*cachedThemeLayout);
     }
 
     setupMenus();
@@ -121,6 +113,33 @@ void ObxfAudioProcessorEditor::clearAndResetComponents(ObxfAudioProcessor &owner
     themeLocation = utils.getCurrentThemeLocation();
 }
 
+std::shared_ptr<const ThemeLayout>
+ObxfAudioProcessorEditor::loadThemeLayout(const Utils::ThemeLocation &location)
+{
+    const auto cacheFolder = utils.getDocumentFolder().getChildFile("ThemeCache");
+    juce::MemoryBlock xml;
+
+    if (location.locationType == Utils::EMBEDDED)
+    {
+        xml.append(BinaryData::theme_xml, BinaryData::theme_xmlSize);
+
+        return ThemeLayout::load(xml, cacheFolder.getChildFile("embedded.layout"));
+    }
+
+    const juce::File theme = location.file.getChildFile("theme.xml");
+
+    if (!theme.loadFileAsData(xml))
+    {
+        return nullptr;
+    }
+
+    // one cache file per theme folder, which holds the layout of its latest contents
+    const auto cacheName =
+        juce::String::toHexString(theme.getFullPathName().hashCode64()) + ".layout";
+
+    return ThemeLayout::load(xml, cacheFolder.getChildFile(cacheName));
+}
+
 bool ObxfAudioProcessorEditor::parseAndCreateComponentsFromTheme()
 {
     const juce::File theme = themeLocation.file.getChildFile("theme.xml");
@@ -133,18 +152,16 @@ bool ObxfAudioProcessorEditor::parseAndCreateComponentsFromTheme()
         return false;
     }
 
-    juce::XmlDocument themeXml(theme);
-
-    if (const auto doc = themeXml.getDocumentElement(); !doc)
+    if (const auto layout = loadThemeLayout(themeLocation); !layout)
     {
         setSize(1440, 486);
         return false;
     }
     else
     {
-        if (doc->getTagName() == "obxf-theme")
+        if (layout->isTheme)
         {
-            createComponentsFromXml(doc.get());
+            createComponentsFromLayout(*layout);
         }
 
         resized();
@@ -202,6 +219,10 @@ void ObxfAudioProcessorEditor::clean()
     {
         addChildComponent(*saveDialog);
     }
+    if (patchBrowser)
+    {
+        addChildComponent(*patchBrowser);
+    }
 }
 
 void ObxfAudioProcessorEditor::rebuildComponents(ObxfAudioProcessor &ownerFilter)
@@ -217,11 +238,11 @@ void ObxfAudioProcessorEditor::rebuildComponents(ObxfAudioProcessor &ownerFilter
 }
 
 // Widget creation from XML
-void ObxfAudioProcessorEditor::createComponentsFromXml(const juce::XmlElement *doc)
+void ObxfAudioProcessorEditor::createComponentsFromLayout(const ThemeLayout &layout)
 {
-    createParameterBoundWidgets(doc);
-    createSpecialWidgets(doc);
-    cacheLayoutFromXml(doc);
+    createParameterBoundWidgets(layout);
+    createSpecialWidgets(layout);
+    cacheWidgetLayout(layout);
 
     panelGroups = panelGroupDefinitions();
 
@@ -398,24 +419,24 @@ void ObxfAudioProcessorEditor::createComponentsFromXml(const juce::XmlElement *d
     }
 }
 
-void ObxfAudioProcessorEditor::createParameterBoundWidgets(const juce::XmlElement *doc)
+void ObxfAudioProcessorEditor::createParameterBoundWidgets(const ThemeLayout &layout)
 {
     const auto &knobs = knobRegistry();
     const auto &buttons = buttonRegistry();
     const auto &multiState = multiStateRegistry();
     const auto &lists = listRegistry();
 
-    for (const auto *child : doc->getChildWithTagNameIterator("widget"))
+    for (const auto &widget : layout.widgets)
     {
-        const std::string nameStd = child->getStringAttribute("name").toStdString();
-        const juce::String name = child->getStringAttribute("name");
-        const auto x = child->getIntAttribute("x");
-        const auto y = child->getIntAttribute("y");
-        const auto w = child->getIntAttribute("w");
-        const auto h = child->getIntAttribute("h");
-        const auto d = child->getIntAttribute("d");
-        const auto fh = child->getIntAttribute("fh");
-        const auto pic = child->getStringAttribute("pic");
+        const std::string nameStd = widget.name.toStdString();
+        const juce::String &name = widget.name;
+        const auto x = widget.x;
+        const auto y = widget.y;
+        const auto w = widget.w;
+        const auto h = widget.h;
+        const auto d = widget.d;
+        const auto fh = widget.fh;
+        const auto &pic = widget.pic;
 
         if (auto it = knobs.find(nameStd); it != knobs.end())
         {
@@ -494,22 +515,21 @@ void ObxfAudioProcessorEditor::createParameterBoundWidgets(const juce::XmlElemen
     }
 }
 
-void ObxfAudioProcessorEditor::createSpecialWidgets(const juce::XmlElement *doc)
+void ObxfAudioProcessorEditor::createSpecialWidgets(const ThemeLayout &layout)
 {
     using namespace SynthParam;
 
-    for (const auto *child : doc->getChildWithTagNameIterator("widget"))
+    for (const auto &widget : layout.widgets)
     {
-        const juce::String name = child->getStringAttribute("name");
-        const auto x = child->getIntAttribute("x");
-        const auto y = child->getIntAttribute("y");
-        const auto w = child->getIntAttribute("w");
-        const auto h = child->getIntAttribute("h");
-        const auto d = child->getIntAttribute("d");
-        const auto fh = child->getIntAttribute("fh");
-        const auto pic = child->getStringAttribute("pic");
-        const auto color =
-            juce::Colour(child->getStringAttribute("color", "FFFF0000").getHexValue32());
+        const juce::String &name = widget.name;
+        const auto x = widget.x;
+        const auto y = widget.y;
+        const auto w = widget.w;
+        const auto h = widget.h;
+        const auto d = widget.d;
+        const auto fh = widget.fh;
+        const auto &pic = widget.pic;
+        const auto color = juce::Colour(widget.color);
 
         // Skip anything already handled by the parameter-bound pass
         if (componentMap.count(name))
@@ -923,14 +943,7 @@ void ObxfAudioProcessorEditor::createSpecialWidgets(const juce::XmlElement *doc)
 
             raw->setBounds(transformBounds(x, y, w, h));
 
-            dd->onClick = [this]() {
-                juce::PopupMenu m;
-                createPatchList(m);
-                m.showMenuAsync(obxf::defaultPopupMenuOptions(this), [this](int i) {
-                    if (i)
-                        MenuActionCallback(i);
-                });
-            };
+            dd->onClick = [this]() { showPatchBrowser(); };
 
             continue;
         }
@@ -1117,24 +1130,21 @@ void ObxfAudioProcessorEditor::createSpecialWidgets(const juce::XmlElement *doc)
         {
             saveDialog->boundsMap[name.toStdString()] = juce::Rectangle<int>(x, y, w, h);
 
-            if (child->hasAttribute("color"))
+            if (widget.hasColor)
             {
-                saveDialog->colorMap[name.toStdString()] =
-                    juce::Colour(child->getStringAttribute("color").getHexValue32());
+                saveDialog->colorMap[name.toStdString()] = color;
             }
         }
     }
 }
 
-void ObxfAudioProcessorEditor::cacheLayoutFromXml(const juce::XmlElement *doc)
+void ObxfAudioProcessorEditor::cacheWidgetLayout(const ThemeLayout &layout)
 {
     cachedLayout.clear();
 
-    for (const auto *child : doc->getChildWithTagNameIterator("widget"))
+    for (const auto &widget : layout.widgets)
     {
-        cachedLayout.push_back({child->getStringAttribute("name"), child->getIntAttribute("x"),
-                                child->getIntAttribute("y"), child->getIntAttribute("w"),
-                                child->getIntAttribute("h"), child->getIntAttribute("d")});
+        cachedLayout.push_back({widget.name, widget.x, widget.y, widget.w, widget.h, widget.d});
     }
 }
 
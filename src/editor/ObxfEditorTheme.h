@@ -18,8 +18,10 @@
 
 static constexpr int defKnobDiameter = 40;
 
-// Theme lifecycle
-void loadTheme(ObxfAudioProcessor &);
+// Theme lifecycle. The compiled layout and the images are shared with other instances
+// showing the same theme; reload reads the images from disk again
+void loadTheme(ObxfAudioProcessor &, bool reload = false);
+std::shared_ptr<const ThemeLayout> loadThemeLayout(const Utils::ThemeLocation &location);
 std::map<juce::String, float> saveComponentParameterValues();
 void clearAndResetComponents(ObxfAudioProcessor &);
 bool parseAndCreateComponentsFromTheme();
@@ -28,11 +30,11 @@ void finalizeThemeLoad(ObxfAudioProcessor &ownerFilter);
 void clean();
 void rebuildComponents(ObxfAudioProcessor &ownerFilter);
 
-// Widget creation from XML
-void createComponentsFromXml(const juce::XmlElement *doc);
-void createParameterBoundWidgets(const juce::XmlElement *doc);
-void createSpecialWidgets(const juce::XmlElement *doc);
-void cacheLayoutFromXml(const juce::XmlElement *doc);
+// Widget creation from the compiled theme
+void createComponentsFromLayout(const ThemeLayout &layout);
+void createParameterBoundWidgets(const ThemeLayout &layout);
+void createSpecialWidgets(const ThemeLayout &layout);
+void cacheWidgetLayout(const ThemeLayout &layout);
 
 template <typename T> T *getWidget(const juce::String &name) const
 {
@@ -92,4 +94,7 @@ friend struct AboutScreen;
 std::unique_ptr<SaveDialog> saveDialog;
 friend struct SaveDialog;
 
+std::unique_ptr<PatchBrowser> patchBrowser;
+friend struct PatchBrowser;
+
 std::function<void(std::function<void()>)> updateFilterVisibility;
\ No newline at end of file
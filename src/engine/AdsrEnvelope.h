@@ -139,6 +139,9 @@ class ADSREnvelope
         }
     }
 
+    /* Release time in milliseconds as currently applied, including offsets and matrix. */
+    float getReleaseMilliseconds() const { return par.r; }
+
     /* Apply a matrix-driven attack time without touching orig.a.
      * Safe to call every sample — does not interfere with setEnvOffsets(). */
     void applyMatrixAttack(float ms)
@@ -25,16 +25,16 @@
 class Decimator17
 {
   private:
-    const float h0{0.5f};
-    const float h1{0.314356238f};
-    const float h3{-0.0947515890f};
-    const float h5{0.0463142134f};
-    const float h7{-0.0240881704f};
-    const float h9{0.0120250406f};
-    const float h11{-0.00543170841f};
-    const float h13{0.00207426259f};
-    const float h15{-0.000572688237f};
-    const float h17{5.18944944E-5f};
+    static constexpr float h0{0.5f};
+    static constexpr float h1{0.314356238f};
+    static constexpr float h3{-0.0947515890f};
+    static constexpr float h5{0.0463142134f};
+    static constexpr float h7{-0.0240881704f};
+    static constexpr float h9{0.0120250406f};
+    static constexpr float h11{-0.00543170841f};
+    static constexpr float h13{0.00207426259f};
+    static constexpr float h15{-0.000572688237f};
+    static constexpr float h17{5.18944944E-5f};
 
     float R1{0.f};
     float R2{0.f};
@@ -100,12 +100,12 @@ class Decimator17
 class Decimator9
 {
   private:
-    const float h0{8192.f / 16384.0f};
-    const float h1{5042.f / 16384.f};
-    const float h3{-1277.f / 16384.f};
-    const float h5{429.f / 16384.f};
-    const float h7{-116.f / 16384.f};
-    const float h9{18.f / 16384.f};
+    static constexpr float h0{8192.f / 16384.0f};
+    static constexpr float h1{5042.f / 16384.f};
+    static constexpr float h3{-1277.f / 16384.f};
+    static constexpr float h5{429.f / 16384.f};
+    static constexpr float h7{-116.f / 16384.f};
+    static constexpr float h9{18.f / 16384.f};
 
     float R1{0.f};
     float R2{0.f};
@@ -43,7 +43,8 @@ class LFO
 
         float smoothedOutput{0.f};
 
-        juce::Random rng;
+        // juce::Random's seed rather than the Random itself, which isn't trivially copyable
+        juce::int64 rngSeed{0};
 
         struct Waves
         {
@@ -61,6 +62,15 @@ class LFO
         int blockPos{blockFactor - 1};
     } state;
 
+    // the same sequence juce::Random would draw from rngSeed
+    float nextRandom()
+    {
+        juce::Random rng(state.rngSeed);
+        const auto r = rng.nextFloat();
+        state.rngSeed = rng.getSeed();
+        return r;
+    }
+
   public:
     struct Parameters
     {
@@ -73,10 +83,13 @@ class LFO
         float wave3blend{0.f};
     } par;
 
-    LFO()
+    LFO() { setSeed(0); }
+
+    // Restarts the sample and hold sequence
+    void setSeed(uint32_t seed)
     {
-        state.rng = juce::Random();
-        state.wave.samplehold = state.rng.nextFloat() * 2.f - 1.f;
+        state.rngSeed = static_cast<juce::int64>(seed);
+        state.wave.samplehold = nextRandom() * 2.f - 1.f;
         state.wave.history = state.wave.samplehold;
     }
 
@@ -179,7 +192,7 @@ class LFO
             {
                 state.phase -= twoPi;
                 state.wave.history = state.wave.samplehold;
-                state.wave.samplehold = state.rng.nextFloat() * 2.f - 1.f;
+                state.wave.samplehold = nextRandom() * 2.f - 1.f;
             }
 
             if constexpr (blockFactor == 1)
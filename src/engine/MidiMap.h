@@ -37,6 +37,8 @@ class MidiMap
     };
     std::array<int, NUM_MIDI_CC> controllers{};
     std::array<juce::String, NUM_MIDI_CC> controllerParamID{};
+    // index into ParameterList, so the audio thread can dispatch without string lookups
+    std::array<int, NUM_MIDI_CC> controllerParamIndex{};
     std::array<TransformMethods, NUM_MIDI_CC> transformMethods{};
     std::array<int, NUM_MIDI_CC> stepValues{};
 
@@ -50,6 +52,7 @@ class MidiMap
     {
         controllers.fill(-1);
         controllerParamID.fill("");
+        controllerParamIndex.fill(-1);
         transformMethods.fill(DEFAULT);
         stepValues.fill(1);
     }
@@ -66,12 +69,18 @@ class MidiMap
         return controllers[index];
     }
 
-    juce::String getParamID(int index) const
+    const juce::String &getParamID(int index) const
     {
         assert(index < NUM_MIDI_CC);
         return controllerParamID[index];
     }
 
+    int getParamListIndex(int index) const
+    {
+        assert(index < NUM_MIDI_CC);
+        return controllerParamIndex[index];
+    }
+
     float ccTo01(size_t index, int cc) const
     {
         assert(index < NUM_MIDI_CC);
@@ -169,6 +178,7 @@ class MidiMap
             {
                 controllers[i] = -1;
                 controllerParamID[i] = "";
+                controllerParamIndex[i] = -1;
             }
         }
 
@@ -200,6 +210,7 @@ class MidiMap
             if (controllers[i] == -1)
             {
                 controllerParamID[i] = "";
+                controllerParamIndex[i] = -1;
             }
             else
             {
@@ -210,11 +221,16 @@ class MidiMap
 
     void resyncParamIDCacheFor(int midiCC)
     {
-        for (const auto &paramInfo : ParameterList)
+        controllerParamIndex[midiCC] = -1;
+
+        for (size_t idx = 0; idx < ParameterList.size(); ++idx)
         {
+            const auto &paramInfo = ParameterList[idx];
+
             if (paramInfo.meta.id == static_cast<uint32_t>(controllers[midiCC]))
             {
                 controllerParamID[midiCC] = paramInfo.ID;
+                controllerParamIndex[midiCC] = static_cast<int>(idx);
                 transformMethods[midiCC] = DEFAULT;
                 if (paramInfo.ID.toStdString() == ID::Osc1Pitch ||
                     paramInfo.ID.toStdString() == ID::Osc2Pitch)
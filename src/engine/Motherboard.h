@@ -20,6 +20,9 @@
 #define OBXF_SRC_ENGINE_MOTHERBOARD_H
 
 #include <climits>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
 #include <Constants.h>
 #include "VoiceQueue.h"
 #include "SynthEngine.h"
@@ -48,6 +51,69 @@ class Motherboard
     float sampleRate{1.f};
     float sampleRateInv{1.f};
 
+    // every instance sounds a little different unless a seed is set
+    uint32_t seed{static_cast<uint32_t>(juce::Random::getSystemRandom().nextInt())};
+
+    static constexpr uint32_t snapshotMagic{0x4f425853}; // 'OBXS'
+
+    struct SnapshotHeader
+    {
+        uint32_t magic{0};
+        uintptr_t process{0};
+        size_t size{0};
+        int voiceQueueIdx{-1};
+    };
+
+    // differs between processes, and with it the address of the BLEP tables
+    static uintptr_t snapshotProcessStamp()
+    {
+        static const char here{0};
+        return reinterpret_cast<uintptr_t>(&here);
+    }
+
+    // Everything cloneFrom copies, apart from tuning and the voice queue which hold pointers
+    template <typename Self, typename Fn> static void visitSnapshotState(Self &mb, Fn &&visit)
+    {
+        // snapshots memcpy every member, so anything which isn't plain data mustn't get in here
+        const auto fn = [&visit](auto &m) {
+            static_assert(std::is_trivially_copyable_v<std::remove_cvref_t<decltype(m)>>,
+                          "snapshot state must be trivially copyable");
+            visit(m);
+        };
+
+        fn(mb.left);
+        fn(mb.right);
+        fn(mb.lastAllocatedIdx);
+        fn(mb.totalVoiceCount);
+        fn(mb.unisonVoiceCount);
+        fn(mb.wasUnisonSet);
+        fn(mb.stolenVoicesOnMIDIKey);
+        fn(mb.stolenVoicesChannelForMIDIKey);
+        fn(mb.voiceAgeForPriority);
+        fn(mb.asPlayedCounter);
+        fn(mb.sampleRate);
+        fn(mb.sampleRateInv);
+        fn(mb.seed);
+        fn(mb.voices);
+        fn(mb.globalLFO);
+        fn(mb.vibratoLFO);
+        fn(mb.voicePriority);
+        fn(mb.vibratoAmount);
+        fn(mb.volume);
+        fn(mb.pannings);
+        fn(mb.anySounding);
+        fn(mb.unison);
+        fn(mb.oversample);
+        fn(mb.reallocate);
+        fn(mb.mpeEnabled);
+        fn(mb.mpePitchBendRange);
+        fn(mb.isSustainOn);
+        fn(mb.voiceMatrix);
+    }
+
+    // what the voices tune through; our own tuning unless shareTuning pointed it elsewhere
+    Tuning *voiceTuning{&tuning};
+
     // JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Motherboard)
 
   public:
@@ -102,13 +168,183 @@ class Motherboard
 
         for (int i = 0; i < MAX_VOICES; i++)
         {
-            voices[i].initTuning(&tuning);
+            voices[i].initTuning(voiceTuning);
             voices[i].voiceIndex = i;
         }
+
+        reseed();
     }
 
     ~Motherboard() {}
 
+    /*
+     * Tune the voices through another motherboard's tuning from now on. The patch crossfade
+     * shadow uses the main engine's, so its tails follow MTS-ESP retuning like the voices
+     * they were cloned from, without registering a second MTS-ESP client.
+     */
+    void shareTuning(Tuning &t)
+    {
+        voiceTuning = &t;
+
+        for (int i = 0; i < MAX_VOICES; i++)
+        {
+            voices[i].initTuning(voiceTuning);
+        }
+    }
+
+    /*
+     * All randomness in the engine (analog slop, noise, oscillator detune and start phases,
+     * LFO sample and hold) is derived from one seed, and every stream restarts from it when
+     * the seed or the sample rate is set. So the same seed, patch and events render the same
+     * output, bit for bit, on the same build.
+     */
+    void setSeed(uint32_t s)
+    {
+        seed = s;
+        reseed();
+    }
+
+    uint32_t getSeed() const { return seed; }
+
+    void reseed()
+    {
+        globalLFO.setSeed(Noise::deriveSeed(seed, 0));
+        vibratoLFO.setSeed(Noise::deriveSeed(seed, 1));
+
+        for (int i = 0; i < MAX_VOICES; ++i)
+        {
+            voices[i].setSeed(Noise::deriveSeed(seed, 2 + static_cast<uint32_t>(i)));
+        }
+    }
+
+    /*
+     * Take over the complete voice, modulation and allocator state of another motherboard.
+     * This is how the patch crossfade shadow picks up the sounding voices; it copies into
+     * existing storage so it is safe on the audio thread. Tuning owns the MTS-ESP client so it
+     * is not copied, and the voices get re-pointed at the tuning we use.
+     */
+    void cloneFrom(const Motherboard &other)
+    {
+        left = other.left;
+        right = other.right;
+
+        lastAllocatedIdx = other.lastAllocatedIdx;
+        totalVoiceCount = other.totalVoiceCount;
+        unisonVoiceCount = other.unisonVoiceCount;
+        wasUnisonSet = other.wasUnisonSet;
+
+        std::copy(std::begin(other.stolenVoicesOnMIDIKey), std::end(other.stolenVoicesOnMIDIKey),
+                  std::begin(stolenVoicesOnMIDIKey));
+        std::copy(std::begin(other.stolenVoicesChannelForMIDIKey),
+                  std::end(other.stolenVoicesChannelForMIDIKey),
+                  std::begin(stolenVoicesChannelForMIDIKey));
+        std::copy(std::begin(other.voiceAgeForPriority), std::end(other.voiceAgeForPriority),
+                  std::begin(voiceAgeForPriority));
+
+        asPlayedCounter = other.asPlayedCounter;
+        sampleRate = other.sampleRate;
+        sampleRateInv = other.sampleRateInv;
+        seed = other.seed;
+
+        for (int i = 0; i < MAX_VOICES; i++)
+        {
+            voices[i] = other.voices[i];
+            voices[i].initTuning(voiceTuning);
+        }
+
+        voiceQueue = VoiceQueue(MAX_VOICES, voices);
+        voiceQueue.reInit(totalVoiceCount);
+        voiceQueue.setIdx(other.voiceQueue.getIdx());
+
+        globalLFO = other.globalLFO;
+        vibratoLFO = other.vibratoLFO;
+
+        voicePriority = other.voicePriority;
+        vibratoAmount = other.vibratoAmount;
+        volume = other.volume;
+        std::copy(std::begin(other.pannings), std::end(other.pannings), std::begin(pannings));
+        anySounding = other.anySounding;
+        unison = other.unison;
+        oversample = other.oversample;
+        reallocate = other.reallocate;
+        mpeEnabled = other.mpeEnabled;
+        mpePitchBendRange = other.mpePitchBendRange;
+        isSustainOn = other.isSustainOn;
+
+        voiceMatrix = other.voiceMatrix;
+    }
+
+    /*
+     * The running state cloneFrom takes over, as one flat block of bytes: voices with their
+     * oscillators, filters, envelopes, LFOs and noise, the global LFOs, the allocator and the
+     * decimators. Everything in there is plain data, so taking or restoring a snapshot is a
+     * handful of memcpys, cheap enough to fork a render from any point and go back to it for
+     * every branch.
+     *
+     * The oscillators point into the BLEP tables, so a snapshot only restores in the process
+     * which took it, and restore refuses anything else.
+     */
+    size_t getSnapshotSize() const
+    {
+        size_t size{sizeof(SnapshotHeader)};
+
+        visitSnapshotState(*this, [&size](const auto &m) { size += sizeof(m); });
+
+        return size;
+    }
+
+    void snapshot(void *dest) const
+    {
+        const SnapshotHeader header{snapshotMagic, snapshotProcessStamp(), getSnapshotSize(),
+                                    voiceQueue.getIdx()};
+        auto *p = static_cast<uint8_t *>(dest);
+
+        std::memcpy(p, &header, sizeof(header));
+        p += sizeof(header);
+
+        visitSnapshotState(*this, [&p](const auto &m) {
+            std::memcpy(p, static_cast<const void *>(&m), sizeof(m));
+            p += sizeof(m);
+        });
+    }
+
+    bool restore(const void *src, size_t size)
+    {
+        SnapshotHeader header;
+
+        if (size < sizeof(header))
+        {
+            return false;
+        }
+
+        std::memcpy(&header, src, sizeof(header));
+
+        if (header.magic != snapshotMagic || header.process != snapshotProcessStamp() ||
+            header.size != getSnapshotSize() || size < header.size)
+        {
+            return false;
+        }
+
+        auto *p = static_cast<const uint8_t *>(src) + sizeof(header);
+
+        visitSnapshotState(*this, [&p](auto &m) {
+            std::memcpy(static_cast<void *>(&m), p, sizeof(m));
+            p += sizeof(m);
+        });
+
+        // as in cloneFrom, the voices keep using our tuning and the queue our voices
+        for (int i = 0; i < MAX_VOICES; i++)
+        {
+            voices[i].initTuning(voiceTuning);
+        }
+
+        voiceQueue = VoiceQueue(MAX_VOICES, voices);
+        voiceQueue.reInit(totalVoiceCount);
+        voiceQueue.setIdx(header.voiceQueueIdx);
+
+        return true;
+    }
+
     void setPolyphony(int count)
     {
         auto newCount = std::min(count, MAX_VOICES);
@@ -166,6 +402,8 @@ class Motherboard
             voices[i].setSampleRate(sr);
         }
 
+        reseed();
+
         // always execute this when setting SR for the motherboard
         // see GitHub issue #269
         SetHQMode(oversample, true);
@@ -699,6 +937,57 @@ class Motherboard
         return 0.f;
     }
 
+    int getSoundingVoiceCount() const
+    {
+        int count{0};
+
+        for (int i = 0; i < totalVoiceCount; ++i)
+        {
+            count += voices[i].isSounding() ? 1 : 0;
+        }
+
+        return count;
+    }
+
+    /* Whether any voice is still held by a key or the sustain pedal, i.e. more than a tail. */
+    bool anyVoiceHeld() const
+    {
+        for (int i = 0; i < totalVoiceCount; ++i)
+        {
+            if (voices[i].isGatedOrSustainPedaled())
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /* Longest amp envelope release of any voice, i.e. how long we ring after the last note off. */
+    float getReleaseTailMilliseconds() const
+    {
+        float ms{0.f};
+
+        for (int i = 0; i < totalVoiceCount; ++i)
+        {
+            ms = std::max(ms, voices[i].ampEnv.getReleaseMilliseconds());
+        }
+
+        return ms;
+    }
+
+    /* Advance free-running state over a block in which nothing is sounding. */
+    void processIdle(int numSamples)
+    {
+        const int steps = oversample ? numSamples * 2 : numSamples;
+
+        for (int i = 0; i < steps; ++i)
+        {
+            globalLFO.update(true);
+            vibratoLFO.update(true);
+        }
+    }
+
     void processSample(float *sm1, float *sm2)
     {
         if (!anySounding)
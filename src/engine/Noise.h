@@ -37,6 +37,17 @@ class Noise
     Use this whenever you want to ensure a repeatable pseudo-random sequence */
     inline void seedWhiteNoise(int32_t seed = 0) { white.state = seed; };
 
+    /* Derives an independent seed for one of several random streams from a parent seed,
+    so that neighbouring streams (say, voice 3 and voice 4) don't produce correlated output */
+    static constexpr uint32_t deriveSeed(uint32_t seed, uint32_t stream)
+    {
+        // splitmix32 finalizer
+        uint32_t z = seed + (stream + 1u) * 0x9e3779b9u;
+        z = (z ^ (z >> 16)) * 0x85ebca6bu;
+        z = (z ^ (z >> 13)) * 0xc2b2ae35u;
+        return z ^ (z >> 16);
+    }
+
     // Gets the next 32-bit signed integer value (full range)
     inline int32_t getRandomValue()
     {
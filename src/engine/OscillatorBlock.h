@@ -156,7 +156,12 @@ class OscillatorBlock
         sampleRateInv = 1.f / sampleRate;
 
         gen.noise.setSampleRate(sampleRate);
-        gen.noise.seedWhiteNoise(std::rand());
+    }
+
+    // Restarts the noise and draws new detune slop and start phases; call after setSampleRate
+    void setSeed(uint32_t seed)
+    {
+        gen.noise.seedWhiteNoise(static_cast<int32_t>(seed));
 
         osc1.tuningSlop = gen.noise.getWhite();
         osc2.tuningSlop = gen.noise.getWhite();
@@ -28,13 +28,21 @@ class Program
     {
         name = INIT_PATCH_NAME;
         setToDefaultPatch();
+
+        slots.reserve(ParameterList.size());
+
+        for (const auto &param : ParameterList)
+        {
+            slots.push_back(&values[param.ID]);
+        }
     }
 
     ~Program() {}
 
     void setToDefaultPatch()
     {
-        values.clear();
+        // values always holds every parameter, so this overwrites rather than clears
+        // and the slots stay valid
         for (const auto &param : ParameterList)
         {
             values[param.ID] = param.meta.naturalToNormalized01(param.meta.defaultVal);
@@ -54,6 +62,9 @@ class Program
 
     void setValueById(const juce::String &id, float v) { values[id].store(v); }
 
+    // The value of ParameterList[index], for loops over many parameters without ID lookups
+    std::atomic<float> &valueAt(size_t index) { return *slots[index]; }
+
     void setName(const juce::String &newName) { name = newName; }
     juce::String getName() const { return name; }
 
@@ -78,6 +89,9 @@ class Program
     std::unordered_map<juce::String, std::atomic<float>> values;
 
   private:
+    // values in ParameterList order; map nodes never move, and values is never cleared
+    std::vector<std::atomic<float> *> slots;
+
     juce::String name, author, license, category, project;
 };
 
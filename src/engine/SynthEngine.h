@@ -19,6 +19,7 @@
 #ifndef OBXF_SRC_ENGINE_SYNTHENGINE_H
 #define OBXF_SRC_ENGINE_SYNTHENGINE_H
 
+#include <array>
 #include <core/Constants.h>
 #include "Voice.h"
 #include "Motherboard.h"
@@ -43,6 +44,8 @@ class SynthEngine
 
     float sampleRate;
 
+    using smootherState_t = std::array<Smoother, 5>;
+
     // clever trick to avoid nested ternary, which provides 0.f -> 0.f, 0.5f -> 1.f, 1.f -> -1.f
     // we use it for inverting LFO modulations per target via tri-state buttons
     float remapZeroHalfOneToZeroOneMinusOne(float x)
@@ -66,6 +69,58 @@ class SynthEngine
 
     ~SynthEngine() {}
 
+    // Copies all sounding state from another engine without allocating; see Motherboard::cloneFrom
+    void cloneFrom(const SynthEngine &other)
+    {
+        cutoffSmoother = other.cutoffSmoother;
+        resSmoother = other.resSmoother;
+        filterModeSmoother = other.filterModeSmoother;
+        pitchBendSmoother = other.pitchBendSmoother;
+        modWheelSmoother = other.modWheelSmoother;
+        sampleRate = other.sampleRate;
+
+        synth.cloneFrom(other.synth);
+    }
+
+    /*
+     * The motherboard's snapshot (see Motherboard::snapshot) followed by the smoothers, so
+     * restoring picks up mid glide exactly where the snapshot was taken.
+     */
+    size_t getSnapshotSize() const { return synth.getSnapshotSize() + sizeof(smootherState_t); }
+
+    void snapshot(void *dest) const
+    {
+        const smootherState_t smoothers{cutoffSmoother, resSmoother, filterModeSmoother,
+                                        pitchBendSmoother, modWheelSmoother};
+
+        synth.snapshot(dest);
+        std::memcpy(static_cast<uint8_t *>(dest) + synth.getSnapshotSize(), &smoothers,
+                    sizeof(smoothers));
+    }
+
+    bool restore(const void *src, size_t size)
+    {
+        if (size != getSnapshotSize() || !synth.restore(src, synth.getSnapshotSize()))
+        {
+            return false;
+        }
+
+        smootherState_t smoothers;
+        std::memcpy(&smoothers, static_cast<const uint8_t *>(src) + synth.getSnapshotSize(),
+                    sizeof(smoothers));
+
+        cutoffSmoother = smoothers[0];
+        resSmoother = smoothers[1];
+        filterModeSmoother = smoothers[2];
+        pitchBendSmoother = smoothers[3];
+        modWheelSmoother = smoothers[4];
+
+        return true;
+    }
+
+    bool isSounding() const { return synth.anySounding; }
+    bool isHeld() const { return synth.anyVoiceHeld(); }
+
     void setPlayHead(float bpm, float retrPos, bool resetPosition)
     {
         synth.globalLFO.hostSyncRetrigger(bpm, retrPos, resetPosition);
@@ -88,6 +143,10 @@ class SynthEngine
         synth.setSampleRate(sr);
     }
 
+    // See Motherboard::setSeed
+    void setSeed(uint32_t seed) { synth.setSeed(seed); }
+    uint32_t getSeed() const { return synth.getSeed(); }
+
     void processSample(float *left, float *right)
     {
         auto co = cutoffSmoother.smoothStep();
@@ -120,6 +179,30 @@ class SynthEngine
         synth.processSample(left, right);
     }
 
+    /*
+     * Equivalent of calling processSample() numSamples times while nothing is sounding.
+     * The output would be silence, so we only keep the smoothers and LFO phases moving.
+     */
+    void processIdle(int numSamples)
+    {
+        float mw{synth.vibratoAmount};
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            cutoffSmoother.smoothStep();
+            resSmoother.smoothStep();
+            filterModeSmoother.smoothStep();
+            pitchBendSmoother.smoothStep();
+            mw = modWheelSmoother.smoothStep();
+        }
+
+        processModWheelSmoothed(mw);
+
+        synth.processIdle(numSamples);
+    }
+
+    float getReleaseTailSeconds() const { return synth.getReleaseTailMilliseconds() * 0.001f; }
+
     float getVoiceAmpEnvStatus(uint8_t idx) { return synth.voices[idx].getVoiceAmpEnvStatus(); };
 
     Motherboard *getMotherboard() { return &synth; };
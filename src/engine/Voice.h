@@ -164,16 +164,25 @@ class Voice
     DelayLine<B_SAMPLES * OVERSAMPLE_FACTOR, float> ampEnvDelayed, filterEnvDelayed, lfo1Delayed,
         lfo2Delayed;
 
-    Voice()
+    Voice() {}
+
+    ~Voice() = default;
+
+    // Draws this voice's slop and restarts all of its random streams from the seed
+    void setSeed(uint32_t seed)
     {
-        slop.level = juce::Random::getSystemRandom().nextFloat() - 0.5f;
-        slop.ampEnv = juce::Random::getSystemRandom().nextFloat() - 0.5f;
-        slop.filterEnv = juce::Random::getSystemRandom().nextFloat() - 0.5f;
-        slop.cutoff = juce::Random::getSystemRandom().nextFloat() - 0.5f;
-        slop.portamento = juce::Random::getSystemRandom().nextFloat() - 0.5f;
-    }
+        juce::Random rng(static_cast<juce::int64>(Noise::deriveSeed(seed, 0)));
 
-    ~Voice() {}
+        slop.level = rng.nextFloat() - 0.5f;
+        slop.ampEnv = rng.nextFloat() - 0.5f;
+        slop.filterEnv = rng.nextFloat() - 0.5f;
+        slop.cutoff = rng.nextFloat() - 0.5f;
+        slop.portamento = rng.nextFloat() - 0.5f;
+
+        noiseGen.seedWhiteNoise(static_cast<int32_t>(Noise::deriveSeed(seed, 1)));
+        oscs.setSeed(Noise::deriveSeed(seed, 2));
+        lfo2.setSeed(Noise::deriveSeed(seed, 3));
+    }
 
     void initTuning(Tuning *t) { tuning = t; }
 
@@ -444,7 +453,6 @@ class Voice
         lfo2.setSampleRate(sr);
         ampEnv.setSampleRate(sr);
         noiseGen.setSampleRate(sr);
-        noiseGen.seedWhiteNoise(std::rand());
 
         setBrightness(par.osc.brightness);
     }
@@ -456,10 +464,10 @@ class Voice
     }
 
     float getVoiceAmpEnvStatus() { return sounding * ampEnvLevel; }
-    bool isSounding() { return sounding; }
-    bool isGated() { return gated; }
-    bool isGatedWithSustain() { return gatedWithSustain; }
-    bool isGatedOrSustainPedaled() { return gated || gatedWithSustain; }
+    bool isSounding() const { return sounding; }
+    bool isGated() const { return gated; }
+    bool isGatedWithSustain() const { return gatedWithSustain; }
+    bool isGatedOrSustainPedaled() const { return gated || gatedWithSustain; }
 
     void ResetEnvelope()
     {
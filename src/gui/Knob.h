@@ -455,69 +455,102 @@ class Knob final : public juce::Slider,
         repaint();
     }
 
-    void paint(juce::Graphics &g) override
+    // Draws the SVG layers of a knob for a value, in a w x h area. Static, so the same
+    // code paints knobs directly and renders their filmstrips on a worker thread
+    static void paintSvgLayers(juce::Graphics &g, const ScalingImageCache::SvgLayers &layers,
+                               SvgTranslationMode mode, float width, float height, float frameH,
+                               float v01)
     {
-        if (isSVG)
+        if (layers.empty() || !layers[0])
+            return;
+
+        const auto &l0 = layers[0];
+        auto vpm1 = 2 * v01 - 1;
+        auto ang = vpm1 * juce::MathConstants<float>::pi * 0.75;
+
+        juce::AffineTransform baseXF, l1XF;
+
+        switch (mode)
         {
-            auto &l0 = imageCache.getSVGDrawable(img_name.toStdString(), 0);
-            auto v01 =
-                static_cast<float>((getValue() - getMinimum()) / (getMaximum() - getMinimum()));
-            auto vpm1 = 2 * v01 - 1;
-            auto ang = vpm1 * juce::MathConstants<float>::pi * 0.75;
+        case ROTATION:
+        {
+            auto kscale = std::min(width, height) / l0->getWidth();
+            baseXF = juce::AffineTransform().scaled(kscale);
 
-            juce::AffineTransform baseXF, l1XF;
+            l1XF = baseXF.translated(-width / 2.f, -height / 2.f)
+                       .rotated(ang)
+                       .translated(width / 2.f, height / 2.f);
+            break;
+        }
+        case HORIZONTAL:
+        {
+            auto kscale = width / l0->getWidth();
+            baseXF = juce::AffineTransform().scaled(kscale);
 
-            switch (svgTranslationMode)
-            {
-            case ROTATION:
-            {
-                auto kscale = std::min(getWidth(), getHeight()) * 1.f / l0->getWidth();
-                baseXF = juce::AffineTransform().scaled(kscale);
+            auto l2 = frameH * kscale;
+            l1XF = baseXF.translated(v01 * (width - l2), 0.f);
+            break;
+        }
+        case VERTICAL:
+        {
+            auto kscale = height / l0->getHeight();
+            baseXF = juce::AffineTransform().scaled(kscale);
 
-                l1XF = baseXF.translated(-getWidth() / 2.f, -getHeight() / 2.f)
-                           .rotated(ang)
-                           .translated(getWidth() / 2.f, getHeight() / 2.f);
-                break;
-            }
-            case HORIZONTAL:
-            {
-                auto kscale = getWidth() * 1.f / l0->getWidth();
-                baseXF = juce::AffineTransform().scaled(kscale);
+            auto l2 = frameH * kscale;
+            l1XF = baseXF.translated(0.f, -(v01 * (height - l2)));
+            break;
+        }
+        }
 
-                auto l2 = h2 * kscale;
-                l1XF = baseXF.translated(v01 * (getWidth() - l2), 0.f);
-                break;
-            }
-            case VERTICAL:
-            {
-                auto kscale = getHeight() * 1.f / l0->getHeight();
-                baseXF = juce::AffineTransform().scaled(kscale);
+        if (layers.size() == 1)
+        {
+            l0->draw(g, 1.f, l1XF);
+        }
+        else
+        {
+            l0->draw(g, 1.f, baseXF);
+        }
+        if (layers.size() > 1 && layers[1])
+        {
+            layers[1]->draw(g, 1.f, l1XF);
+        }
+        if (layers.size() > 2 && layers[2])
+        {
+            layers[2]->draw(g, 1.f, baseXF);
+        }
+    }
 
-                auto l2 = h2 * kscale;
-                l1XF = baseXF.translated(0.f, -(v01 * (getHeight() - l2)));
-                break;
-            }
-            }
+    void paint(juce::Graphics &g) override
+    {
+        if (isSVG)
+        {
+            const auto label = img_name.toStdString();
+            const auto v01 =
+                static_cast<float>((getValue() - getMinimum()) / (getMaximum() - getMinimum()));
+            const auto w = static_cast<float>(getWidth());
+            const auto h = static_cast<float>(getHeight());
+
+            const auto strip = imageCache.getFilmstrip(
+                label, fmt::format("{}/{}", static_cast<int>(svgTranslationMode), h2), getWidth(),
+                getHeight(), g.getInternalContext().getPhysicalPixelScaleFactor(),
+                [mode = svgTranslationMode, w, h, fh = static_cast<float>(h2)](
+                    juce::Graphics &sg, const ScalingImageCache::SvgLayers &layers, float v) {
+                    paintSvgLayers(sg, layers, mode, w, h, fh, v);
+                });
 
-            if (imageCache.getSvgLayerCount(img_name.toStdString()) == 1)
+            if (strip.isValid())
             {
-                l0->draw(g, 1.f, l1XF);
-            }
-            else
-            {
-                l0->draw(g, 1.f, baseXF);
-            }
-            if (imageCache.getSvgLayerCount(img_name.toStdString()) > 1)
-            {
-                auto &l1 = imageCache.getSVGDrawable(img_name.toStdString(), 1);
+                constexpr int lastFrame = ScalingImageCache::filmstripFrames - 1;
+                const int frameH = strip.getHeight() / ScalingImageCache::filmstripFrames;
+                const int frame = juce::jlimit(0, lastFrame, juce::roundToInt(v01 * lastFrame));
 
-                l1->draw(g, 1.f, l1XF);
+                g.drawImage(strip, 0, 0, getWidth(), getHeight(), 0, frame * frameH,
+                            strip.getWidth(), frameH);
             }
-            if (imageCache.getSvgLayerCount(img_name.toStdString()) > 2)
+            else
             {
-                auto &l2 = imageCache.getSVGDrawable(img_name.toStdString(), 2);
-
-                l2->draw(g, 1.f, baseXF);
+                paintSvgLayers(g, imageCache.getSVGLayers(label), svgTranslationMode, w, h,
+                               static_cast<float>(h2), v01);
             }
         }
         else
@@ -0,0 +1,327 @@
+/*
+ * OB-Xd was originally written by Vadim Filatov, and then a version
+ * was released under the GPL3 at https://github.com/reales/OB-Xd.
+ * Subsequently, the product was continued by DiscoDSP and the copyright
+ * holders as an excellent closed source product.
+ *
+ * This repository is a successor to OB-Xd version 2.11.
+ * Copyright 2013-2025 by the authors as indicated in the original release,
+ * and subsequent authors as per GitHub transaction log.
+ *
+ * OB-Xf is released under the GNU General Public Licence v3 or later
+ * (GPL-3.0-or-later). The license is found in the file "LICENSE"
+ * in the root of this repository or at:
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * Source code is available at https://github.com/surge-synthesizer/OB-Xf
+ */
+
+#ifndef OBXF_SRC_GUI_PATCHBROWSER_H
+#define OBXF_SRC_GUI_PATCHBROWSER_H
+
+#include <algorithm>
+
+#include <juce_gui_basics/juce_gui_basics.h>
+
+#include "ObxfEditor.h"
+
+/*
+ * Patch browser overlay. The list is a virtualized ListBox over the linear patch list,
+ * so opening it costs the same for ten patches as for ten thousand: only visible rows
+ * are ever painted, and the unfiltered view maps rows straight onto list indices.
+ * Typing in the filter searches the metadata index.
+ */
+struct PatchBrowser final : juce::Component, juce::ListBoxModel
+{
+    static constexpr int contentWidth{560};
+    static constexpr int contentHeight{400};
+    static constexpr int rowHeight{20};
+    static constexpr int margin{8};
+
+    ObxfAudioProcessorEditor &editor;
+
+    PatchBrowser(ObxfAudioProcessorEditor &editor) : editor(editor)
+    {
+        filter.setTextToShowWhenEmpty("Filter by name, author, category, project or license",
+                                      juce::Colours::grey);
+        filter.setEscapeAndReturnKeysConsumed(true);
+        filter.onTextChange = [this]() { applyFilter(); };
+        filter.onReturnKey = [this]() { loadRow(list.getSelectedRow()); };
+        filter.onEscapeKey = [this]() { setVisible(false); };
+        addAndMakeVisible(filter);
+
+        list.setModel(this);
+        list.setColour(juce::ListBox::backgroundColourId, juce::Colour(0xFF1A1A1A));
+        list.setColour(juce::ListBox::outlineColourId, juce::Colour(0xFF505050));
+        list.setOutlineThickness(1);
+        addAndMakeVisible(list);
+
+        functions.onClick = [this]() {
+            juce::PopupMenu m;
+            this->editor.addPatchFunctions(m);
+            m.showMenuAsync(obxf::defaultPopupMenuOptions(&functions),
+                            [w = juce::Component::SafePointer(&this->editor)](int i) {
+                                if (w && i)
+                                    w->MenuActionCallback(i);
+                            });
+        };
+        addAndMakeVisible(functions);
+
+        close.onClick = [this]() { setVisible(false); };
+        addAndMakeVisible(close);
+    }
+
+    ~PatchBrowser() override { list.setModel(nullptr); }
+
+    // Rows of the current view are indices into utils.patchesAsLinearList. Unfiltered,
+    // that is the identity and nothing is stored at all
+    std::vector<int> filteredRows;
+    bool isFiltered{false};
+
+    int listIndexForRow(int row) const
+    {
+        if (!isFiltered)
+        {
+            return row;
+        }
+
+        return row >= 0 && row < static_cast<int>(filteredRows.size()) ? filteredRows[row] : -1;
+    }
+
+    Utils::PatchTreeNode::ptr_t nodeForRow(int row) const
+    {
+        const auto &patches = editor.utils.patchesAsLinearList;
+        const auto idx = listIndexForRow(row);
+
+        // the patch list may be republished while we are open
+        if (idx < 0 || idx >= static_cast<int>(patches.size()))
+        {
+            return nullptr;
+        }
+
+        return patches[idx];
+    }
+
+    int rowForListIndex(int idx) const
+    {
+        if (!isFiltered)
+        {
+            return idx;
+        }
+
+        const auto it = std::find(filteredRows.begin(), filteredRows.end(), idx);
+
+        return it != filteredRows.end() ? static_cast<int>(it - filteredRows.begin()) : -1;
+    }
+
+    void applyFilter()
+    {
+        const auto query = filter.getText().trim();
+
+        isFiltered = query.isNotEmpty();
+        filteredRows.clear();
+
+        if (isFiltered)
+        {
+            if (editor.utils.patchMetadata)
+            {
+                filteredRows = editor.utils.searchPatches(query);
+            }
+            else
+            {
+                // metadata is still being gathered, names are all we have
+                const auto &patches = editor.utils.patchesAsLinearList;
+
+                for (size_t i = 0; i < patches.size(); ++i)
+                {
+                    if (patches[i]->displayName.containsIgnoreCase(query))
+                    {
+                        filteredRows.push_back(static_cast<int>(i));
+                    }
+                }
+            }
+        }
+
+        list.updateContent();
+        selectLoadedPatch();
+    }
+
+    void selectLoadedPatch()
+    {
+        const auto row = rowForListIndex(editor.processor.lastLoadedProgram);
+
+        if (row >= 0 && row < getNumRows())
+        {
+            list.selectRow(row);
+            list.scrollToEnsureRowIsOnscreen(row);
+        }
+        else
+        {
+            list.deselectAllRows();
+            list.scrollToEnsureRowIsOnscreen(0);
+        }
+    }
+
+    void loadRow(int row)
+    {
+        if (const auto node = nodeForRow(row))
+        {
+            editor.utils.loadPatch(node);
+            list.repaint();
+        }
+    }
+
+    // ListBoxModel
+    int getNumRows() override
+    {
+        return isFiltered ? static_cast<int>(filteredRows.size())
+                          : static_cast<int>(editor.utils.patchesAsLinearList.size());
+    }
+
+    void paintListBoxItem(int row, juce::Graphics &g, int width, int height,
+                          bool selected) override
+    {
+        const auto node = nodeForRow(row);
+
+        if (!node)
+        {
+            return;
+        }
+
+        const auto idx = listIndexForRow(row);
+
+        if (selected)
+        {
+            g.fillAll(juce::Colour(0xFF3A3A3A));
+        }
+
+        juce::String author, category;
+
+        if (const auto &metadata = editor.utils.patchMetadata;
+            metadata && static_cast<size_t>(idx) < metadata->size())
+        {
+            author = metadata->get(PatchMetadataIndex::Author, static_cast<size_t>(idx));
+            category = metadata->get(PatchMetadataIndex::Category, static_cast<size_t>(idx));
+        }
+
+        juce::String folder = Utils::toString(node->locationType);
+
+        if (const auto parent = node->parent.lock(); parent && parent->parent.lock())
+        {
+            folder << " / " << parent->displayName;
+        }
+
+        const auto isLoaded = idx == editor.processor.lastLoadedProgram;
+        const auto pad = height / 4;
+        auto r = juce::Rectangle<int>(0, 0, width, height).reduced(pad, 0);
+
+        g.setFont(editor.patchNameFont.withHeight(height * 0.85f));
+        g.setColour(isLoaded ? juce::Colour(0xFFFF4040) : juce::Colours::white);
+        g.drawText(node->displayName, r.removeFromLeft(width * 4 / 10), juce::Justification::left,
+                   true);
+
+        g.setFont(juce::FontOptions(height * 0.6f));
+        g.setColour(juce::Colours::lightgrey);
+        g.drawText(folder, r.removeFromLeft(width * 3 / 10), juce::Justification::left, true);
+
+        if (category.isNotEmpty())
+        {
+            author << (author.isNotEmpty() ? " (" : "(") << category << ")";
+        }
+
+        g.drawText(author, r, juce::Justification::left, true);
+    }
+
+    void listBoxItemDoubleClicked(int row, const juce::MouseEvent &) override { loadRow(row); }
+    void returnKeyPressed(int row) override { loadRow(row); }
+
+    bool keyPressed(const juce::KeyPress &key) override
+    {
+        if (key == juce::KeyPress::escapeKey)
+        {
+            setVisible(false);
+            return true;
+        }
+
+        return false;
+    }
+
+    void mouseUp(const juce::MouseEvent &event) override
+    {
+        // clicking the dimmed area around the browser dismisses it
+        if (!getContentArea().contains(event.getPosition()))
+        {
+            setVisible(false);
+        }
+    }
+
+    void resized() override
+    {
+        const auto sc = editor.impliedScaleFactor();
+        const auto rh = juce::roundToInt(rowHeight * sc);
+        const auto m = juce::roundToInt(margin * sc);
+
+        auto r = getContentArea().reduced(m);
+        auto top = r.removeFromTop(rh + m / 2);
+
+        close.setBounds(top.removeFromRight(rh * 4));
+        top.removeFromRight(m / 2);
+        functions.setBounds(top.removeFromRight(rh * 4));
+        top.removeFromRight(m);
+        filter.setBounds(top);
+        filter.applyFontToAllText(juce::FontOptions(rh * 0.7f));
+
+        r.removeFromTop(m);
+        list.setRowHeight(rh);
+        list.setBounds(r);
+    }
+
+    void paint(juce::Graphics &g) override
+    {
+        g.fillAll(juce::Colours::black.withAlpha(0.85f));
+
+        const auto r = getContentArea();
+
+        g.setColour(juce::Colour(0xFF262626));
+        g.fillRect(r);
+        g.setColour(juce::Colour(0xFF505050));
+        g.drawRect(r, 1);
+    }
+
+    juce::Rectangle<int> getContentArea() const
+    {
+        const auto sc = editor.impliedScaleFactor();
+
+        return juce::Rectangle<int>(0, 0, juce::roundToInt(contentWidth * sc),
+                                    juce::roundToInt(contentHeight * sc))
+            .constrainedWithin(getLocalBounds())
+            .withCentre(getLocalBounds().getCentre());
+    }
+
+    void showOver(const Component *that, bool focusFilter = false)
+    {
+        setBounds(that->getBounds());
+        resized();
+
+        // the patch list may have been rescanned since we were last open
+        applyFilter();
+
+        setVisible(true);
+        toFront(true);
+
+        if (focusFilter)
+        {
+            filter.grabKeyboardFocus();
+        }
+        else
+        {
+            list.grabKeyboardFocus();
+        }
+    }
+
+    juce::TextEditor filter;
+    juce::ListBox list{"Patches"};
+    juce::TextButton functions{"Functions"}, close{"Close"};
+};
+
+#endif // OBXF_SRC_GUI_PATCHBROWSER_H
@@ -26,11 +26,25 @@
 // we smooth midi into this many steps
 static constexpr int midiBlock{4};
 
+// while a lag is still moving, refresh the UI and program store at roughly this rate
+static constexpr double lagNotifyHz{30.0};
+
+/*
+ * The lag collection only walks the lags which are currently moving, so the per-tick
+ * cost scales with the number of swept controllers. Each step goes straight into the
+ * engine by ParameterList index. At lagNotifyHz the current value is also handed to the
+ * message thread for the UI and the program, and when a lag completes the host is told
+ * from there as well, see notifySettledLags.
+ */
 struct MidiHandler::LagHandler
     : sst::basic_blocks::dsp::LagCollectionBase<128, MidiHandler::LagHandler>
 {
-    const MidiHandler &handler;
-    LagHandler(const MidiHandler &h) : handler(h) {}
+    MidiHandler &handler;
+    LagHandler(MidiHandler &h) : handler(h) {}
+
+    int notifyInterval{1};
+    int notifyCountdown{0};
+    bool notifyThisTick{false};
 
     void setTarget(size_t index, float target)
     {
@@ -38,22 +52,42 @@ struct MidiHandler::LagHandler
         this->setTargetValue(index, target);
     }
 
+    void setNotifyRate(double sampleRate)
+    {
+        notifyInterval = std::max(1, static_cast<int>(sampleRate / (lagNotifyHz * midiBlock)));
+        notifyCountdown = 0;
+    }
+
+    void tick()
+    {
+        notifyThisTick = (notifyCountdown == 0);
+        notifyCountdown = notifyThisTick ? notifyInterval - 1 : notifyCountdown - 1;
+
+        processAll();
+    }
+
     void applyLag(size_t index)
     {
-        // Force the value in the engine change
-        handler.paramCoordinator.getParameterUpdateHandler().forceSingleParameterCallback(
-            handler.bindings.getParamID(index), lags[index].lag.v);
+        const auto paramIndex = handler.bindings.getParamListIndex(index);
+
+        if (paramIndex >= 0)
+        {
+            handler.paramCoordinator.applyEngineParameterByIndex(paramIndex, lags[index].lag.v);
+        }
+
+        if (notifyThisTick)
+        {
+            // the program and the UI follow along from the message thread
+            handler.movingLagValues[index].store(lags[index].lag.v, std::memory_order_relaxed);
+            handler.movingLags[index].store(true, std::memory_order_release);
+        }
     }
 
     void lagCompleted(size_t index)
     {
-        // Notify host when done or when snapped
-        auto &uh = handler.paramCoordinator.getParameterUpdateHandler();
-        uh.setSuppressGestureToUndo(true);
-        handler.paramCoordinator.setEngineParameterValue(
-            handler.synth, handler.bindings.getParamID(index), lags[index].lag.v, true);
-        uh.updateParameters(false);
-        uh.setSuppressGestureToUndo(false);
+        // Notify host when done or when snapped, which has to wait for the message thread
+        handler.settledLagValues[index].store(lags[index].lag.v, std::memory_order_relaxed);
+        handler.settledLags[index].store(true, std::memory_order_release);
     }
 };
 
@@ -84,6 +118,15 @@ void MidiHandler::prepareToPlay()
 {
     nextMidi = std::make_unique<juce::MidiMessage>(0xF0);
     midiMsg = std::make_unique<juce::MidiMessage>(0xF0);
+
+    // a half sent RPN or bank select doesn't carry over into the next playback
+    bankSelectMSB = 0;
+    rpnMSB = 127;
+    rpnLSB = 127;
+    dataEntryMSB = 0;
+    dataEntryLSB = 0;
+
+    snapLags();
 }
 
 void MidiHandler::processMidiPerSample(juce::MidiBufferIterator *iter,
@@ -266,6 +309,11 @@ void MidiHandler::processMidiPerSample(juce::MidiBufferIterator *iter,
             synth.allSoundOff();
         }
 
+        if (shadowSynth)
+        {
+            forwardToShadowEngine();
+        }
+
         if (midiMsg->isProgramChange()) // xC0
         {
             if (handleMIDIProgramChangeCallback)
@@ -278,6 +326,65 @@ void MidiHandler::processMidiPerSample(juce::MidiBufferIterator *iter,
     }
 }
 
+void MidiHandler::forwardToShadowEngine()
+{
+    // The shadow only holds voices from the previous patch, so it never gets new notes;
+    // it just needs enough to release and bend what it is already playing
+    auto &s = *shadowSynth;
+    const auto chan = static_cast<int8_t>(midiMsg->getChannel() - 1);
+    const bool isMPEMember = mpeEnabled.load() && midiMsg->getChannel() != 1;
+
+    if (midiMsg->isNoteOff())
+    {
+        s.processNoteOff(midiMsg->getNoteNumber(), midiMsg->getFloatVelocity(), chan);
+    }
+
+    if (midiMsg->isPitchWheel())
+    {
+        const float pitchVal = (midiMsg->getPitchWheelValue() - 8192) / 8192.0f;
+
+        if (isMPEMember)
+        {
+            s.processMPEPitch(chan, pitchVal);
+        }
+        else
+        {
+            s.processPitchWheel(pitchVal);
+        }
+    }
+
+    if (midiMsg->isChannelPressure())
+    {
+        s.processMPEChannelPressure(isMPEMember ? chan : static_cast<int8_t>(-1),
+                                    midiMsg->getChannelPressureValue() / 127.0f);
+    }
+
+    if (midiMsg->isControllerOfType(1))
+    {
+        s.processModWheel(midiMsg->getControllerValue() / 127.0f);
+    }
+
+    if (midiMsg->isSustainPedalOn())
+    {
+        s.sustainOn();
+    }
+
+    if (midiMsg->isSustainPedalOff() || midiMsg->isAllNotesOff() || midiMsg->isAllSoundOff())
+    {
+        s.sustainOff();
+    }
+
+    if (midiMsg->isAllNotesOff())
+    {
+        s.allNotesOff();
+    }
+
+    if (midiMsg->isAllSoundOff())
+    {
+        s.allSoundOff();
+    }
+}
+
 void MidiHandler::handleRPN()
 {
     if (rpnMSB == 127 && rpnLSB == 127)
@@ -292,7 +399,7 @@ void MidiHandler::handleRPN()
         const int semitones = std::min(static_cast<int>(dataEntryMSB), MAX_MPE_BEND_RANGE);
         const bool isMasterChannel = (midiMsg->getChannel() == 1);
 
-        juce::MessageManager::callAsync([this, semitones, isMasterChannel]() {
+        auto apply = [this, semitones, isMasterChannel]() {
             if (isMasterChannel)
             {
                 processor.setGlobalPitchBendRange(semitones);
@@ -301,7 +408,16 @@ void MidiHandler::handleRPN()
             {
                 processor.setMpePitchBendRange(semitones);
             }
-        });
+        };
+
+        if (applyRPNImmediately)
+        {
+            apply();
+        }
+        else
+        {
+            juce::MessageManager::callAsync(apply);
+        }
         return;
     }
 
@@ -317,8 +433,16 @@ void MidiHandler::handleRPN()
         // dataEntryMSB = number of member channels; 0 = MPE disabled
         const int memberChannels = static_cast<int>(dataEntryMSB);
 
-        juce::MessageManager::callAsync(
-            [this, memberChannels]() { processor.setMpeEnabled(memberChannels > 0); });
+        auto apply = [this, memberChannels]() { processor.setMpeEnabled(memberChannels > 0); };
+
+        if (applyRPNImmediately)
+        {
+            apply();
+        }
+        else
+        {
+            juce::MessageManager::callAsync(apply);
+        }
         return;
     }
 }
@@ -327,7 +451,7 @@ void MidiHandler::processLags()
 {
     if (lagPos == 0)
     {
-        lagHandler->processAll();
+        lagHandler->tick();
     }
 
     lagPos = (lagPos + 1) & (midiBlock - 1);
@@ -356,6 +480,37 @@ bool MidiHandler::getNextEvent(juce::MidiBufferIterator *iter, const juce::MidiB
 void MidiHandler::setSampleRate(double sr)
 {
     lagHandler->setRateInMilliseconds(30, sr, 1.0 / midiBlock);
+    lagHandler->setNotifyRate(sr);
 }
 
 void MidiHandler::snapLags() { lagHandler->snapAllActiveToTarget(); }
+
+void MidiHandler::notifySettledLags()
+{
+    auto &uh = paramCoordinator.getParameterUpdateHandler();
+
+    for (size_t i = 0; i < movingLags.size(); ++i)
+    {
+        if (!movingLags[i].exchange(false, std::memory_order_acquire) ||
+            settledLags[i].load(std::memory_order_relaxed))
+        {
+            continue;
+        }
+
+        paramCoordinator.followEngineParameterValue(bindings.getParamID(i),
+                                                    movingLagValues[i].load());
+    }
+
+    for (size_t i = 0; i < settledLags.size(); ++i)
+    {
+        if (!settledLags[i].exchange(false, std::memory_order_acquire))
+        {
+            continue;
+        }
+
+        uh.setSuppressGestureToUndo(true);
+        paramCoordinator.setEngineParameterValue(synth, bindings.getParamID(i),
+                                                 settledLagValues[i].load(), true);
+        uh.setSuppressGestureToUndo(false);
+    }
+}
@@ -66,12 +66,24 @@ class MidiHandler
     void snapLags();
     void processLags();
 
+    // Message thread: brings the UI and the program along with lags which are still moving,
+    // and tells the host about lags which have come to rest
+    void notifySettledLags();
+
+    // While a patch crossfade is running, releases and expression also go to this engine
+    void setShadowEngine(SynthEngine *s) { shadowSynth = s; }
+
+    // RPNs (bend range, MPE configuration) are applied on the message thread, unless the
+    // caller is the only thread there is, as in an offline render without a message loop
+    void setApplyRPNImmediately(bool b) { applyRPNImmediately = b; }
+
     std::function<void(int)> handleMIDIProgramChangeCallback;
     std::function<void(const juce::MidiMessage &)> onMidiMessageCallback;
     std::function<void()> onMidiLearnBinding;
 
   private:
     SynthEngine &synth;
+    SynthEngine *shadowSynth{nullptr};
     MidiMap &bindings;
     ParameterCoordinator &paramCoordinator;
 
@@ -93,15 +105,23 @@ class MidiHandler
     uint8_t rpnLSB{127};
     uint8_t dataEntryMSB{0};
     uint8_t dataEntryLSB{0};
+    bool applyRPNImmediately{false};
 
     juce::String currentMidiPath;
 
     struct LagHandler;
     std::unique_ptr<LagHandler> lagHandler;
     size_t lagPos{0};
+
+    // lags moving or completed on the audio thread, waiting for notifySettledLags
+    std::array<std::atomic<bool>, 128> movingLags{};
+    std::array<std::atomic<float>, 128> movingLagValues{};
+    std::array<std::atomic<bool>, 128> settledLags{};
+    std::array<std::atomic<float>, 128> settledLagValues{};
     friend struct LagHandler;
 
     void handleRPN();
+    void forwardToShadowEngine();
 
     ObxfAudioProcessor &processor;
 };
@@ -21,9 +21,22 @@
 
 #include <pybind11/pybind11.h>
 #include <pybind11/numpy.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <climits>
+#include <cstring>
+#include <limits>
 #include <stdexcept>
+#include <string>
+#include <string_view>
 
 #include <ObxfProcessor.h>
+#include <ObxdImporter.h>
+#include <OfflineRenderer.h>
+#include <RenderPool.h>
+#include <RenderCache.h>
+#include <DatasetGenerator.h>
 #include <parameter/ParameterCoordinator.h>
 
 namespace py = pybind11;
@@ -31,10 +44,267 @@ namespace py = pybind11;
 namespace obxf::python
 {
 
+// Event kinds as spelled in list form, in RenderEvent::Type order
+static constexpr std::array<const char *, RenderEvent::numTypes> eventKindNames = {
+    "note_on", "note_off", "cc", "pitch_bend", "pressure", "param", "program"};
+
+inline int paramIndexFor(const std::string &paramId)
+{
+    const auto idx = parameterListIndexOf(paramId);
+
+    if (idx < 0)
+    {
+        throw std::invalid_argument("Unknown parameter ID: " + paramId);
+    }
+
+    return idx;
+}
+
+inline uint8_t eventTypeFrom(const py::handle &kind)
+{
+    if (py::isinstance<py::str>(kind))
+    {
+        const auto name = kind.cast<std::string>();
+        const auto it = std::find(eventKindNames.begin(), eventKindNames.end(), name);
+
+        if (it == eventKindNames.end())
+        {
+            throw std::invalid_argument("Unknown event kind: " + name);
+        }
+
+        return static_cast<uint8_t>(it - eventKindNames.begin());
+    }
+
+    return static_cast<uint8_t>(kind.cast<int>());
+}
+
+/*
+ * Accepts either a 1D numpy array of event_dtype, or an iterable of
+ * (time, kind, number, value[, channel]) tuples where kind is a name from
+ * eventKindNames (or its int) and a parameter's number may be its ID string.
+ */
+inline std::vector<RenderEvent> eventsFromPython(const py::object &events, int nSamples)
+{
+    std::vector<RenderEvent> res;
+
+    if (events.is_none())
+    {
+        return res;
+    }
+
+    if (py::isinstance<py::array>(events))
+    {
+        const auto arr =
+            py::array_t<RenderEvent, py::array::c_style | py::array::forcecast>::ensure(events);
+
+        if (!arr || arr.ndim() != 1)
+        {
+            throw std::invalid_argument("events must be a 1D array of obxfpy.event_dtype");
+        }
+
+        res.assign(arr.data(), arr.data() + arr.size());
+    }
+    else
+    {
+        for (const auto &item : events)
+        {
+            const auto t = item.cast<py::sequence>();
+
+            if (t.size() < 4 || t.size() > 5)
+            {
+                throw std::invalid_argument(
+                    "events must be (time, kind, number, value[, channel]) tuples");
+            }
+
+            RenderEvent e;
+            e.time = t[0].cast<int64_t>();
+            e.type = eventTypeFrom(t[1]);
+
+            const auto number = e.type == RenderEvent::Parameter && py::isinstance<py::str>(t[2])
+                                    ? paramIndexFor(t[2].cast<std::string>())
+                                    : t[2].cast<int>();
+
+            if (number < 0 || number > 0xFFFF)
+            {
+                throw std::invalid_argument("Event number out of range: " +
+                                            std::to_string(number));
+            }
+
+            e.number = static_cast<uint16_t>(number);
+            e.value = t[3].cast<float>();
+            e.channel = t.size() > 4 ? t[4].cast<uint8_t>() : 0;
+
+            res.push_back(e);
+        }
+    }
+
+    for (const auto &e : res)
+    {
+        if (e.time < 0 || e.time >= nSamples)
+        {
+            throw std::invalid_argument("Event time " + std::to_string(e.time) +
+                                        " is outside the render span");
+        }
+
+        if (e.type >= RenderEvent::numTypes)
+        {
+            throw std::invalid_argument("Unknown event kind: " + std::to_string(e.type));
+        }
+
+        if (e.channel > 15)
+        {
+            throw std::invalid_argument("Event channel must be 0..15");
+        }
+
+        if (e.type == RenderEvent::Parameter && e.number >= ParameterList.size())
+        {
+            throw std::invalid_argument("Parameter index out of range: " +
+                                        std::to_string(e.number));
+        }
+    }
+
+    return res;
+}
+
+/*
+ * Either a dict of {parameter ID or index: value}, or a full vector of values in
+ * ParameterList order (see parameter_ids). Parameters not given come back as NaN.
+ */
+inline std::vector<float> parametersFromPython(const py::object &params)
+{
+    std::vector<float> res(ParameterList.size(), std::numeric_limits<float>::quiet_NaN());
+
+    if (params.is_none())
+    {
+        return res;
+    }
+
+    if (py::isinstance<py::dict>(params))
+    {
+        for (const auto &[key, value] : params.cast<py::dict>())
+        {
+            const auto idx = py::isinstance<py::str>(key) ? paramIndexFor(key.cast<std::string>())
+                                                           : key.cast<int>();
+
+            if (idx < 0 || idx >= static_cast<int>(res.size()))
+            {
+                throw std::invalid_argument("Parameter index out of range: " +
+                                            std::to_string(idx));
+            }
+
+            res[idx] = value.cast<float>();
+        }
+
+        return res;
+    }
+
+    const auto arr = py::array_t<float, py::array::c_style | py::array::forcecast>::ensure(params);
+
+    if (!arr || arr.ndim() != 1 || static_cast<size_t>(arr.size()) != res.size())
+    {
+        throw std::invalid_argument("params must be a dict or a vector of " +
+                                    std::to_string(res.size()) + " values");
+    }
+
+    std::copy(arr.data(), arr.data() + arr.size(), res.begin());
+
+    return res;
+}
+
+// A float32 curve from Python, converted and made contiguous if it wasn't
+using curve_t = py::array_t<float, py::array::c_style | py::array::forcecast>;
+
+/*
+ * Automation lanes from a dict of parameter ID or index to a 1D curve of 0..1 values.
+ * A curve n_samples long is audio rate, any other length is spread evenly over the
+ * render. IDs are resolved here, once; the curves are kept alive in curves, which has
+ * to outlive the lanes.
+ */
+inline std::vector<AutomationLane> lanesFromPython(const py::object &automation, int nSamples,
+                                                   std::vector<curve_t> &curves)
+{
+    std::vector<AutomationLane> res;
+
+    if (automation.is_none())
+    {
+        return res;
+    }
+
+    for (const auto &[key, value] : automation.cast<py::dict>())
+    {
+        const auto idx = py::isinstance<py::str>(key) ? paramIndexFor(key.cast<std::string>())
+                                                       : key.cast<int>();
+
+        if (idx < 0 || idx >= static_cast<int>(ParameterList.size()))
+        {
+            throw std::invalid_argument("Parameter index out of range: " + std::to_string(idx));
+        }
+
+        auto curve = curve_t::ensure(value);
+
+        if (!curve || curve.ndim() != 1 || curve.size() == 0 || curve.size() > INT_MAX)
+        {
+            throw std::invalid_argument("automation curves must be non empty 1D arrays");
+        }
+
+        AutomationLane lane;
+        lane.index = static_cast<uint16_t>(idx);
+        lane.points = curve.data();
+        lane.numPoints = static_cast<int>(curve.size());
+        lane.samplesPerPoint = std::max(1, nSamples) / static_cast<double>(lane.numPoints);
+
+        res.push_back(lane);
+        curves.push_back(std::move(curve));
+    }
+
+    return res;
+}
+
+// A writable, C contiguous float32 stereo buffer, either (2, n) planar or (n, 2) interleaved
+struct StereoOut
+{
+    float *data{nullptr};
+    int frames{0};
+    bool interleaved{false};
+};
+
+inline StereoOut stereoOutFrom(py::array &out)
+{
+    if (!py::isinstance<py::array_t<float>>(out) || out.ndim() != 2 ||
+        !(out.flags() & py::array::c_style) || !out.writeable())
+    {
+        throw std::invalid_argument(
+            "out must be a writable, C contiguous float32 array of shape (2, n) or (n, 2)");
+    }
+
+    StereoOut res;
+
+    if (out.shape(0) == 2)
+    {
+        res.frames = static_cast<int>(std::min<py::ssize_t>(out.shape(1), INT_MAX));
+    }
+    else if (out.shape(1) == 2)
+    {
+        res.frames = static_cast<int>(std::min<py::ssize_t>(out.shape(0), INT_MAX));
+        res.interleaved = true;
+    }
+    else
+    {
+        throw std::invalid_argument("out must have shape (2, n) or (n, 2)");
+    }
+
+    res.data = static_cast<float *>(out.mutable_data());
+
+    return res;
+}
+
 class ObxfPyEngine
 {
   public:
-    ObxfPyEngine(double sampleRate) : processor() { processor.prepareToPlay(sampleRate, 512); }
+    ObxfPyEngine(double sampleRate) : processor(), renderer(processor)
+    {
+        renderer.prepare(sampleRate);
+    }
 
     // --- MIDI ----------------------------------------------------------------
 
@@ -55,6 +325,64 @@ class ObxfPyEngine
     void allNotesOff() { processor.getSynth().allNotesOff(); }
     void allSoundOff() { processor.getSynth().allSoundOff(); }
 
+    // --- Seed ----------------------------------------------------------------
+
+    void setSeed(uint32_t seed) { processor.setRenderSeed(seed); }
+    uint32_t getSeed() const { return processor.getRenderSeed(); }
+
+    // --- Snapshots -----------------------------------------------------------
+
+    // The engine's running state followed by the parameter values, so get_param agrees
+    // with the restored engine
+    py::bytes snapshot() const
+    {
+        const auto &synth = processor.getSynth();
+        const auto &values = processor.getActiveProgram().values;
+        const auto engineSize = synth.getSnapshotSize();
+
+        std::string blob(engineSize + ParameterList.size() * sizeof(float), '\0');
+        synth.snapshot(blob.data());
+
+        auto *params = blob.data() + engineSize;
+
+        for (const auto &param : ParameterList)
+        {
+            const auto it = values.find(param.ID);
+            const float v = it != values.end() ? it->second.load() : 0.f;
+
+            std::memcpy(params, &v, sizeof(v));
+            params += sizeof(v);
+        }
+
+        return py::bytes(blob);
+    }
+
+    void restore(const py::bytes &snapshot)
+    {
+        const auto blob = static_cast<std::string_view>(snapshot);
+        auto &synth = processor.getSynth();
+        const auto engineSize = synth.getSnapshotSize();
+
+        if (blob.size() != engineSize + ParameterList.size() * sizeof(float) ||
+            !synth.restore(blob.data(), engineSize))
+        {
+            throw std::invalid_argument(
+                "Not a snapshot of an engine of this build, taken in this process");
+        }
+
+        auto &values = processor.getActiveProgram().values;
+        const auto *params = blob.data() + engineSize;
+
+        for (const auto &param : ParameterList)
+        {
+            float v;
+            std::memcpy(&v, params, sizeof(v));
+            params += sizeof(v);
+
+            values[param.ID] = v;
+        }
+    }
+
     // --- Parameters ----------------------------------------------------------
 
     void setParam(const std::string &paramId, float value)
@@ -82,6 +410,9 @@ class ObxfPyEngine
         return 0.f;
     }
 
+    // Index of a parameter ID, for the number of param events in a structured array
+    int getParamIndex(const std::string &paramId) const { return paramIndexFor(paramId); }
+
     // Return every parameter ID the handler map knows about
     // Useful for introspection and building Python-side wrappers.
     py::list getParamIds() const
@@ -247,18 +578,9 @@ class ObxfPyEngine
             throw std::runtime_error("Could not read patch file: " + path);
         }
 
-        processor.getStateManager().loadFromMemoryBlock(mb);
-
-        const auto &handlers = obxf::getHandlerMap();
-
-        for (const auto &[paramId, value] : processor.getActiveProgram().values)
+        if (!renderer.loadPatch(mb))
         {
-            auto it = handlers.find(paramId.toStdString());
-
-            if (it != handlers.end())
-            {
-                it->second(processor.getSynth(), value.load());
-            }
+            throw std::runtime_error("Not a valid patch file: " + path);
         }
     }
 
@@ -287,6 +609,21 @@ class ObxfPyEngine
             filename += ".fxp";
         }
 
+        // The patch library is already indexed, so look there before walking the folders
+        const auto &utils = processor.getUtils();
+
+        for (const auto &root : searchRoots)
+        {
+            for (const auto &node : utils.patchesAsLinearList)
+            {
+                if (node->file.getFileName().equalsIgnoreCase(filename) &&
+                    node->file.isAChildOf(root))
+                {
+                    return node->file.getFullPathName().toStdString();
+                }
+            }
+        }
+
         for (const auto &root : searchRoots)
         {
             auto result = root.findChildFiles(juce::File::findFiles, true, filename);
@@ -300,6 +637,68 @@ class ObxfPyEngine
         throw std::runtime_error("Patch not found: " + name);
     }
 
+    py::list searchPatches(const std::string &query, const py::object &fields, bool prefix,
+                           size_t maxResults) const
+    {
+        static const std::array<const char *, PatchMetadataIndex::numFields> fieldNames = {
+            "name", "author", "license", "category", "project"};
+
+        int mask = 0;
+
+        if (fields.is_none())
+        {
+            mask = PatchMetadataIndex::allFields;
+        }
+        else
+        {
+            for (const auto &f : fields)
+            {
+                const auto fieldName = f.cast<std::string>();
+                const auto it = std::find(fieldNames.begin(), fieldNames.end(), fieldName);
+
+                if (it == fieldNames.end())
+                {
+                    throw std::invalid_argument("Unknown patch metadata field: " + fieldName);
+                }
+
+                mask |= PatchMetadataIndex::fieldBit(
+                    static_cast<PatchMetadataIndex::Field>(it - fieldNames.begin()));
+            }
+        }
+
+        const auto &utils = processor.getUtils();
+        const auto metadata = utils.patchMetadata;
+        py::list result;
+
+        if (!metadata)
+        {
+            return result;
+        }
+
+        for (const auto idx : metadata->search(query, mask, prefix, maxResults))
+        {
+            const auto row = static_cast<size_t>(idx);
+
+            if (row >= utils.patchesAsLinearList.size())
+            {
+                break;
+            }
+
+            py::dict d;
+
+            for (int f = 0; f < PatchMetadataIndex::numFields; ++f)
+            {
+                d[fieldNames[f]] =
+                    metadata->get(static_cast<PatchMetadataIndex::Field>(f), row).toStdString();
+            }
+
+            d["path"] = utils.patchesAsLinearList[row]->file.getFullPathName().toStdString();
+            result.append(d);
+        }
+
+        return result;
+    }
+
     // --- Audio ---------------------------------------------------------------
 
     py::tuple process(int nSamples)
@@ -307,32 +706,489 @@ class ObxfPyEngine
         auto outL = py::array_t<float>(nSamples);
         auto outR = py::array_t<float>(nSamples);
 
-        auto l = outL.mutable_unchecked<1>();
-        auto r = outR.mutable_unchecked<1>();
+        auto *l = outL.mutable_data();
+        auto *r = outR.mutable_data();
 
         {
             py::gil_scoped_release release;
-            SynthEngine &synth = processor.getSynth();
-            for (int i = 0; i < nSamples; ++i)
-            {
-                float ls = 0.f, rs = 0.f;
-                synth.processSample(&ls, &rs);
-                l(i) = ls;
-                r(i) = rs;
-            }
+            renderer.render(noEvents, nSamples, l, r);
         }
 
         return py::make_tuple(outL, outR);
     }
 
+    // Fills all of out, without allocating anything when there are no events
+    int processInto(py::array out, const py::object &events)
+    {
+        const auto o = stereoOutFrom(out);
+        auto evs = eventsFromPython(events, o.frames);
+
+        {
+            py::gil_scoped_release release;
+            renderInto(o, 0, o.frames, evs);
+        }
+
+        return o.frames;
+    }
+
+    // Writes n_samples into a ring buffer from write_pos on, wrapping around its end
+    int processIntoRing(py::array ring, py::ssize_t writePos, int nSamples)
+    {
+        const auto o = stereoOutFrom(ring);
+
+        if (o.frames == 0 || nSamples < 0 || nSamples > o.frames)
+        {
+            throw std::invalid_argument("n_samples must be between 0 and the ring size");
+        }
+
+        const auto pos = static_cast<int>(((writePos % o.frames) + o.frames) % o.frames);
+
+        {
+            py::gil_scoped_release release;
+            const auto first = std::min(nSamples, o.frames - pos);
+
+            renderInto(o, pos, first, noEvents);
+            renderInto(o, 0, nSamples - first, noEvents);
+        }
+
+        return (pos + nSamples) % o.frames;
+    }
+
+    py::tuple render(const py::object &events, int nSamples, const py::object &automation)
+    {
+        if (nSamples < 0)
+        {
+            throw std::invalid_argument("n_samples must not be negative");
+        }
+
+        auto evs = eventsFromPython(events, nSamples);
+
+        std::vector<curve_t> curves;
+        const auto lanes = lanesFromPython(automation, nSamples, curves);
+
+        auto outL = py::array_t<float>(nSamples);
+        auto outR = py::array_t<float>(nSamples);
+
+        auto *l = outL.mutable_data();
+        auto *r = outR.mutable_data();
+
+        {
+            py::gil_scoped_release release;
+            renderer.render(evs, lanes, nSamples, l, r);
+        }
+
+        return py::make_tuple(outL, outR);
+    }
+
+    // --- Telemetry -----------------------------------------------------------
+
+    py::dict getDspLoad() const
+    {
+        const auto s = processor.getDspLoadMeter().snapshot();
+
+        py::dict d;
+        d["mean"] = s.mean;
+        d["p99"] = s.p99;
+        d["max"] = s.max;
+        d["blocks"] = s.blocks;
+        d["sounding_voices"] = s.soundingVoices;
+        d["high_quality"] = s.highQuality;
+
+        return d;
+    }
+
   private:
+    void renderInto(const StereoOut &o, int offset, int nSamples, std::vector<RenderEvent> &evs)
+    {
+        if (nSamples <= 0)
+        {
+            return;
+        }
+
+        if (o.interleaved)
+        {
+            renderer.renderInterleaved(evs, nSamples, o.data + 2 * static_cast<size_t>(offset));
+        }
+        else
+        {
+            renderer.render(evs, nSamples, o.data + offset, o.data + o.frames + offset);
+        }
+    }
+
     ObxfAudioProcessor processor;
+    OfflineRenderer renderer;
+    std::vector<RenderEvent> noEvents;
+};
+
+// -------------------------------------------------------------------------
+
+class ObxfPyRenderPool
+{
+  public:
+    ObxfPyRenderPool(int numWorkers, double sampleRate, const py::object &cacheFolder,
+                     int64_t cacheMaxBytes)
+    {
+        juce::File folder;
+
+        if (!cacheFolder.is_none())
+        {
+            folder = juce::File(juce::String(py::str(cacheFolder).cast<std::string>()));
+        }
+
+        py::gil_scoped_release release;
+        pool = std::make_unique<RenderPool>(numWorkers, sampleRate);
+
+        if (folder != juce::File())
+        {
+            cache = std::make_unique<RenderCache>(folder, cacheMaxBytes);
+            pool->setCache(cache.get());
+        }
+    }
+
+    int getNumWorkers() const { return pool->getNumWorkers(); }
+    int getCacheHits() const { return cacheHits; }
+    int64_t getCacheSize() const { return cache ? cache->getSizeInBytes() : 0; }
+
+    void clearCache()
+    {
+        if (cache)
+        {
+            cache->clear();
+        }
+    }
+
+    /*
+     * Each job is a dict with any of patch (path), params (see parametersFromPython),
+     * events (as for ObxfEngine.render) and n_samples (default, and at most, the length
+     * of out). Job i renders into out[i], which must be (n_jobs, 2, n) float32.
+     */
+    py::list render(const py::iterable &jobs, py::array out)
+    {
+        if (!py::isinstance<py::array_t<float>>(out) || out.ndim() != 3 || out.shape(1) != 2 ||
+            !(out.flags() & py::array::c_style) || !out.writeable())
+        {
+            throw std::invalid_argument(
+                "out must be a writable, C contiguous float32 array of shape (n_jobs, 2, n)");
+        }
+
+        const auto rows = static_cast<size_t>(out.shape(0));
+        const auto maxSamples = static_cast<int>(std::min<py::ssize_t>(out.shape(2), INT_MAX));
+        auto *base = static_cast<float *>(out.mutable_data());
+
+        std::vector<RenderPool::Job> batch;
+
+        for (const auto &item : jobs)
+        {
+            if (batch.size() >= rows)
+            {
+                throw std::invalid_argument("out has fewer rows than there are jobs");
+            }
+
+            const auto d = item.cast<py::dict>();
+            RenderPool::Job job;
+
+            job.numSamples = d.contains("n_samples") ? d["n_samples"].cast<int>() : maxSamples;
+
+            if (job.numSamples < 0 || job.numSamples > maxSamples)
+            {
+                throw std::invalid_argument("n_samples must be between 0 and out.shape[2]");
+            }
+
+            if (d.contains("patch") && !d["patch"].is_none())
+            {
+                job.patch = juce::File(juce::String(py::str(d["patch"]).cast<std::string>()));
+            }
+
+            if (d.contains("params"))
+            {
+                job.parameters = parametersFromPython(d["params"]);
+            }
+
+            if (d.contains("events"))
+            {
+                job.events = eventsFromPython(d["events"], job.numSamples);
+            }
+
+            if (d.contains("seed"))
+            {
+                job.seed = d["seed"].cast<uint32_t>();
+            }
+
+            job.left = base + batch.size() * 2 * static_cast<size_t>(maxSamples);
+            job.right = job.left + maxSamples;
+
+            batch.push_back(std::move(job));
+        }
+
+        {
+            py::gil_scoped_release release;
+
+            for (auto &job : batch)
+            {
+                std::fill(job.left + job.numSamples, job.left + maxSamples, 0.f);
+                std::fill(job.right + job.numSamples, job.right + maxSamples, 0.f);
+            }
+
+            pool->render(batch);
+        }
+
+        py::list errors;
+        cacheHits = 0;
+
+        for (const auto &job : batch)
+        {
+            errors.append(job.error.empty() ? py::object(py::none()) : py::str(job.error));
+            cacheHits += job.cached ? 1 : 0;
+        }
+
+        return errors;
+    }
+
+  private:
+    // the pool uses the cache, so it has to go first
+    std::unique_ptr<RenderCache> cache;
+    std::unique_ptr<RenderPool> pool;
+    int cacheHits{0};
 };
 
+// ParameterList order, which is the order of a params vector
+inline py::list parameterIds()
+{
+    py::list ids;
+
+    for (const auto &param : ParameterList)
+    {
+        ids.append(param.ID.toStdString());
+    }
+
+    return ids;
+}
+
 // -------------------------------------------------------------------------
 
+// Bulk OB-Xd bank conversion, see ObxdImporter::importBanks
+inline py::dict importObxdBanks(const py::iterable &paths, const std::string &destFolder,
+                                int numWorkers, const py::object &progress)
+{
+    std::vector<juce::File> banks;
+
+    for (const auto &p : paths)
+    {
+        banks.emplace_back(juce::String(py::str(p).cast<std::string>()));
+    }
+
+    ObxdImporter::BankImportOptions options;
+    options.numWorkers = numWorkers;
+
+    std::unique_ptr<py::error_already_set> error;
+
+    if (!progress.is_none())
+    {
+        options.progress = [&](const ObxdImporter::BankImportProgress &p) {
+            py::gil_scoped_acquire gil;
+
+            try
+            {
+                progress(p.banksRead, p.banksTotal, p.patchesWritten);
+            }
+            catch (py::error_already_set &e)
+            {
+                error = std::make_unique<py::error_already_set>(std::move(e));
+            }
+        };
+    }
+
+    // stop on Ctrl-C or an exception from the progress callback
+    options.shouldCancel = [&]() {
+        py::gil_scoped_acquire gil;
+
+        if (!error && PyErr_CheckSignals() != 0)
+        {
+            error = std::make_unique<py::error_already_set>();
+        }
+
+        return error != nullptr;
+    };
+
+    ObxdImporter::BankImportResult result;
+
+    {
+        py::gil_scoped_release release;
+        result = ObxdImporter::importBanks(banks, juce::File(destFolder),
+                                           &Utils::serializeProgramToMemoryBlock, options);
+    }
+
+    if (error)
+    {
+        throw std::move(*error);
+    }
+
+    py::dict d;
+    d["imported"] = result.imported;
+    d["skipped"] = result.skipped;
+    d["failed_banks"] = result.failedBanks;
+
+    return d;
+}
+
+// Patch x pitch x velocity datasets, see DatasetGenerator
+inline py::dict generateDataset(const std::string &outputFolder, const py::iterable &patches,
+                                const py::sequence &notes, const py::iterable &velocities,
+                                double noteLength, double tail, double sampleRate,
+                                int shardSize, const std::string &format, int numWorkers,
+                                uint32_t seed, const py::object &progress)
+{
+    DatasetGenerator::Spec spec;
+
+    for (const auto &p : patches)
+    {
+        spec.patches.emplace_back(juce::String(py::str(p).cast<std::string>()));
+    }
+
+    if (notes.size() < 2 || notes.size() > 3)
+    {
+        throw std::invalid_argument("notes must be (lowest, highest) or (lowest, highest, step)");
+    }
+
+    if (format != "npy" && format != "wav")
+    {
+        throw std::invalid_argument("format must be npy or wav");
+    }
+
+    spec.lowestNote = notes[0].cast<int>();
+    spec.highestNote = notes[1].cast<int>();
+    spec.noteStep = notes.size() == 3 ? notes[2].cast<int>() : 1;
+    spec.velocities.clear();
+
+    for (const auto &v : velocities)
+    {
+        spec.velocities.push_back(v.cast<int>());
+    }
+
+    spec.noteSeconds = noteLength;
+    spec.tailSeconds = tail;
+    spec.sampleRate = sampleRate;
+    spec.shardSize = shardSize;
+    spec.format = format == "wav" ? DatasetGenerator::Wav : DatasetGenerator::Npy;
+    spec.seed = seed;
+
+    DatasetGenerator generator(spec, juce::File(juce::String(outputFolder)));
+
+    std::unique_ptr<py::error_already_set> error;
+    std::atomic<bool> cancel{false};
+
+    // between shards: report progress, and stop on Ctrl-C or an exception from the callback
+    const auto onShard = [&](int done, int total) {
+        py::gil_scoped_acquire gil;
+
+        try
+        {
+            if (!progress.is_none())
+            {
+                progress(done, total);
+            }
+
+            if (PyErr_CheckSignals() != 0)
+            {
+                throw py::error_already_set();
+            }
+        }
+        catch (py::error_already_set &e)
+        {
+            error = std::make_unique<py::error_already_set>(std::move(e));
+            cancel.store(true);
+        }
+    };
+
+    DatasetGenerator::Result result;
+
+    {
+        py::gil_scoped_release release;
+        result = generator.run(numWorkers, onShard, &cancel);
+    }
+
+    if (error)
+    {
+        throw std::move(*error);
+    }
+
+    if (!result.error.empty())
+    {
+        throw std::runtime_error(result.error);
+    }
+
+    py::dict d;
+    d["shards"] = result.shards;
+    d["rendered_shards"] = result.renderedShards;
+    d["skipped_shards"] = result.skippedShards;
+    d["failed_items"] = result.failedItems;
+    d["items"] = spec.numItems();
+    d["n_samples"] = spec.numSamples();
+
+    return d;
+}
+
 inline void registerObxfPython(py::module_ &m)
 {
+    PYBIND11_NUMPY_DTYPE(RenderEvent, time, type, channel, number, value);
+
+    m.attr("event_dtype") = py::dtype::of<RenderEvent>();
+
+    for (size_t i = 0; i < eventKindNames.size(); ++i)
+    {
+        m.attr(juce::String(eventKindNames[i]).toUpperCase().toRawUTF8()) = i;
+    }
+
+    m.def("import_obxd_banks", &importObxdBanks, py::arg("paths"), py::arg("dest_folder"),
+          py::arg("n_workers") = 0, py::arg("progress") = py::none(),
+          "Convert OB-Xd FXB banks into OB-Xf FXP patches, each bank into a subfolder of "
+          "dest_folder. Programs are translated on n_workers threads (0 for one per core). "
+          "progress, if given, is called with (banks_read, banks_total, patches_written). "
+          "Returns a dict with imported, skipped and failed_banks counts.");
+
+    m.def("generate_dataset", &generateDataset, py::arg("output_folder"), py::arg("patches"),
+          py::arg("notes") = py::make_tuple(36, 84), py::arg("velocities") = py::make_tuple(127),
+          py::arg("note_length") = 1.0, py::arg("tail") = 1.0, py::arg("sample_rate") = 48000.0,
+          py::arg("shard_size") = 128, py::arg("format") = "npy", py::arg("n_workers") = 0,
+          py::arg("seed") = 0, py::arg("progress") = py::none(),
+          "Render every patch x note x velocity as one note, held for note_length seconds and "
+          "released for tail seconds, on n_workers threads without the GIL. notes is (lowest, "
+          "highest[, step]). Items are written shard_size at a time to output_folder as "
+          "shard-NNNNN.npy (float32, (n, 2, samples)) or, with format wav, shard-NNNNN/ folders "
+          "of WAV files, each with a shard-NNNNN.json item list; manifest.jsonl lists all items "
+          "once every shard is done. Running it again with the same spec renders only the "
+          "missing shards. progress, if given, is called with (shards_done, shards_total). "
+          "Returns a dict with shards, rendered_shards, skipped_shards, failed_items, items "
+          "and n_samples.");
+
+    m.def("parameter_ids", &parameterIds,
+          "Return every parameter ID in index order, the order of a params vector and of "
+          "get_param_index.");
+
+    py::class_<ObxfPyRenderPool>(m, "RenderPool",
+                                 "A pool of independent engines on native threads.")
+        .def(py::init<int, double, const py::object &, int64_t>(), py::arg("n_workers") = 0,
+             py::arg("sample_rate") = 44100.0, py::arg("cache") = py::none(),
+             py::arg("cache_max_bytes") = int64_t(1) << 30,
+             "Create n_workers engines (0 for one per core) running at sample_rate. With a "
+             "cache folder, every render is stored there keyed by a hash of everything it "
+             "depends on, and a job rendered before is read back instead of rendered again. "
+             "The least recently used renders are deleted beyond cache_max_bytes.")
+        .def_property_readonly("n_workers", &ObxfPyRenderPool::getNumWorkers)
+        .def_property_readonly("cache_hits", &ObxfPyRenderPool::getCacheHits,
+                               "How many jobs of the last render came from the cache.")
+        .def_property_readonly("cache_size", &ObxfPyRenderPool::getCacheSize,
+                               "Bytes held in the cache folder.")
+        .def("clear_cache", &ObxfPyRenderPool::clearCache, "Delete every cached render.")
+        .def("render", &ObxfPyRenderPool::render, py::arg("jobs"), py::arg("out"),
+             "Render a batch of jobs in parallel, without the GIL. Each job is a dict with "
+             "optional patch (FXP path, otherwise the init patch), params (dict of ID or index "
+             "to value, or a vector in parameter_ids order), events (as for ObxfEngine.render), "
+             "seed (default 0) and n_samples. Job i renders into out[i], a float32 array of shape "
+             "(n_jobs, 2, n), padded with silence past n_samples. Returns a list holding None "
+             "for each job that rendered, or an error message.");
+
+
     py::class_<ObxfPyEngine>(m, "ObxfEngine", "Create an OB-Xf instance.")
 
         .def(py::init<double>(), py::arg("sample_rate") = 44100.0,
@@ -350,6 +1206,22 @@ inline void registerObxfPython(py::module_ &m)
         .def("all_notes_off", &ObxfPyEngine::allNotesOff)
         .def("all_sound_off", &ObxfPyEngine::allSoundOff)
 
+        // Seed
+        .def("set_seed", &ObxfPyEngine::setSeed, py::arg("seed"),
+             "Derive all randomness (analog slop, noise, LFO sample and hold) from seed, so the "
+             "same patch and events render bit identical audio. Kept when saving the state.")
+        .def("get_seed", &ObxfPyEngine::getSeed, "Return the engine seed.")
+
+        // Snapshots
+        .def("snapshot", &ObxfPyEngine::snapshot,
+             "Return the complete running state (voices, oscillators, filters, envelopes, "
+             "LFOs, smoothers, noise) and parameter values as bytes. Taking one costs a few "
+             "microseconds.")
+        .def("restore", &ObxfPyEngine::restore, py::arg("snapshot"),
+             "Put the engine back exactly as it was when snapshot() returned this, so renders "
+             "can branch from a shared prefix. Snapshots are only good in the process which "
+             "took them.")
+
         // Parameters
         .def("set_param", &ObxfPyEngine::setParam, py::arg("param_id"), py::arg("value"),
              "Set a parameter by its ID string.")
@@ -357,6 +1229,8 @@ inline void registerObxfPython(py::module_ &m)
              "Get the last set value for a parameter ID.")
         .def("get_param_ids", &ObxfPyEngine::getParamIds,
              "Return a list of all known parameter ID strings.")
+        .def("get_param_index", &ObxfPyEngine::getParamIndex, py::arg("param_id"),
+             "Return the index of a parameter ID, for param events in an event_dtype array.")
 
         // MPE
         .def("set_mpe_modulation", &ObxfPyEngine::setMatrixRow, py::arg("dimension"),
@@ -381,16 +1255,49 @@ inline void registerObxfPython(py::module_ &m)
              "Return the user patches folder path.")
 
         // Patches
-        .def("load_patch", &ObxfPyEngine::loadPatch, py::arg("path"), "Load an FXP patch.")
+        .def("load_patch", &ObxfPyEngine::loadPatch, py::arg("path"),
+             "Load an FXP patch or a saved state.")
         .def("save_patch", &ObxfPyEngine::savePatch, py::arg("path"),
              "Save current state as FXP patch.")
         .def("find_patch", &ObxfPyEngine::findPatch, py::arg("name"),
              "Search factory then user patches for a file by name (.fxp extension is optional). "
              "Returns full path or throws.")
+        .def("search_patches", &ObxfPyEngine::searchPatches, py::arg("query"),
+             py::arg("fields") = py::none(), py::arg("prefix") = false,
+             py::arg("max_results") = 100,
+             "Search the patch library metadata, ignoring case. fields is a list of "
+             "name/author/license/category/project (default all); with prefix, fields must start "
+             "with the query. Returns a list of dicts with those fields and path.")
 
         // Audio
         .def("process", &ObxfPyEngine::process, py::arg("n_samples"),
-             "Render n_samples. Returns (left, right) as numpy float32 arrays.");
+             "Render n_samples. Returns (left, right) as numpy float32 arrays.")
+        .def("process_into", &ObxfPyEngine::processInto, py::arg("out"),
+             py::arg("events") = py::none(),
+             "Render into out, a writable C contiguous float32 array of shape (2, n) (one row "
+             "per channel) or (n, 2) (interleaved), without allocating. events are as for "
+             "render. Returns n.")
+        .def("process_into_ring", &ObxfPyEngine::processIntoRing, py::arg("ring"),
+             py::arg("write_pos"), py::arg("n_samples"),
+             "Render n_samples into ring, shaped like out for process_into, starting at "
+             "write_pos and wrapping around its end. Returns the next write position.")
+        .def("render", &ObxfPyEngine::render, py::arg("events"), py::arg("n_samples"),
+             py::arg("automation") = py::none(),
+             "Render n_samples with sample accurate events, in one call and without the GIL. "
+             "events is an array of obxfpy.event_dtype (time, type, channel, number, value) or "
+             "a list of (time, kind, number, value[, channel]) tuples. kind is note_on, "
+             "note_off (value is velocity 0..127), cc (0..127), pitch_bend (-1..1), pressure "
+             "(0..127), param (number is the ID or index, value 0..1) or program (number is "
+             "a program of the MIDI Programs folder). Times are sample "
+             "offsets in [0, n_samples). automation is a dict of parameter ID or index to a "
+             "curve of 0..1 values, which is audio rate if n_samples long and otherwise spread "
+             "evenly over the render; a curve wins over param events at the same time. Returns "
+             "(left, right) as numpy float32 arrays.")
+
+        // Telemetry
+        .def("get_dsp_load", &ObxfPyEngine::getDspLoad,
+             "Return DSP load over recent blocks as a dict with mean/p99/max (render time "
+             "relative to block duration), blocks, sounding_voices and high_quality.");
 }
 
 } // namespace obxf::python
@@ -45,44 +45,70 @@ struct ParameterAlgos
     {
     }
 
+    // ParameterList indices of the parameters in each mutate section, worked out once
+    static const std::array<std::vector<size_t>, NUM_SECTIONS_TO_MUTATE> &mutateSectionIndices()
+    {
+        static const auto indices = []() {
+            std::array<std::vector<size_t>, NUM_SECTIONS_TO_MUTATE> res;
+
+            for (size_t s = 0; s < NUM_SECTIONS_TO_MUTATE; ++s)
+            {
+                for (size_t i = 0; i < ParameterList.size(); ++i)
+                {
+                    if (ParameterList[i].meta.hasFeature(mutateSectionList[s]))
+                    {
+                        res[s].push_back(i);
+                    }
+                }
+            }
+
+            return res;
+        }();
+
+        return indices;
+    }
+
     void mutate(Program &program, MutateMask what)
     {
-        std::uniform_int_distribution<> distPL(0, utils.patchesAsLinearList.size() - 1);
-        std::vector<int> indices;
-        auto tempProg = Program();
+        const auto numPatches = utils.patchesAsLinearList.size();
+
+        if (numPatches == 0)
+        {
+            return;
+        }
+
+        std::uniform_int_distribution<size_t> distPL(0, numPatches - 1);
+        std::vector<size_t> indices;
 
         for (int i = 0; i < NUM_SECTIONS_TO_MUTATE; i++)
         {
             if (what.test(i))
             {
                 // grab a patch index for each section we want to mutate
-                // make it non-repeating random picks
+                // make it non-repeating random picks, as long as there are enough patches
                 auto n = distPL(rng);
 
-                while (std::find(std::begin(indices), std::end(indices), n) != indices.end())
+                while (indices.size() < numPatches &&
+                       std::find(std::begin(indices), std::end(indices), n) != indices.end())
                 {
                     n = distPL(rng);
                 }
 
                 indices.push_back(n);
 
-                // load the patch
-                auto p = utils.patchesAsLinearList[n];
-                utils.loadPatch(p->file, tempProg);
+                // decoded by the patch scan, so a pick it hasn't reached yet leaves this
+                // section alone rather than going to disk here
+                const auto values = utils.getDecodedPatch(utils.patchesAsLinearList[n]->file);
+
+                if (!values || values->size() != ParameterList.size())
+                {
+                    continue;
+                }
 
                 // copy only parameters belonging to a particular mutate section (osc, filter, etc.)
-                for (auto &p : program.values)
+                for (const auto idx : mutateSectionIndices()[i])
                 {
-                    for (const auto &paramInfo : ParameterList)
-                    {
-                        if (paramInfo.ID.compare(p.first) == 0)
-                        {
-                            if (paramInfo.meta.hasFeature(mutateSectionList[i]))
-                            {
-                                p.second.store(tempProg.getValueById(p.first));
-                            }
-                        }
-                    }
+                    program.valueAt(idx).store((*values)[idx]);
                 }
             }
         }
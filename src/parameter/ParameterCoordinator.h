@@ -197,6 +197,30 @@ class ParameterCoordinator
         }
     }
 
+    /**
+     * Push a value straight into the engine by ParameterList index. This skips the callback
+     * map and the program store entirely, so it is meant for audio thread callers (like the
+     * MIDI lags) which settle the final value through the regular path afterwards.
+     */
+    void applyEngineParameterByIndex(size_t index, float newValue)
+    {
+        if (index < indexedHandlers.size() && indexedHandlers[index])
+        {
+            indexedHandlers[index](engine, newValue);
+        }
+    }
+
+    /**
+     * The message thread half of applyEngineParameterByIndex: brings the program store and
+     * the UI along with a value the audio thread has already put into the engine, without
+     * telling the engine or the host again.
+     */
+    void followEngineParameterValue(const juce::String &paramId, float newValue)
+    {
+        programState.updateProgramValue(paramId, newValue);
+        updateHandler.forceSingleParameterCallback(paramId, newValue, "UI");
+    }
+
     ParameterUpdateHandler &getParameterUpdateHandler() { return updateHandler; }
     const ParameterUpdateHandler &getParameterUpdateHandler() const { return updateHandler; }
 
@@ -209,6 +233,9 @@ class ParameterCoordinator
   private:
     void setupParameterCallbacks()
     {
+        indexedHandlers.clear();
+        indexedHandlers.reserve(ParameterList.size());
+
         for (const auto &paramInfo : ParameterList)
         {
             const juce::String &paramId = paramInfo.ID;
@@ -216,9 +243,11 @@ class ParameterCoordinator
             if (hid == obxf::getHandlerMap().end())
             {
                 OBLOG(params, "Unable to locate callback for " << paramId);
+                indexedHandlers.emplace_back();
             }
             else
             {
+                indexedHandlers.push_back(hid->second);
                 updateHandler.addParameterCallback(
                     paramId, "PROGRAM",
                     [cb = hid->second, this, paramId](const float newValue, bool /*forced*/) {
@@ -233,6 +262,9 @@ class ParameterCoordinator
     IProgramState &programState;
     ParameterUpdateHandler updateHandler;
     SynthEngine &engine;
+
+    // engine handlers in ParameterList order, for applyEngineParameterByIndex
+    std::vector<Handler> indexedHandlers;
 };
 
 #endif // OBXF_SRC_PARAMETER_PARAMETERCOORDINATOR_H
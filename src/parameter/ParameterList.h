@@ -274,4 +274,18 @@ static const std::vector<ParameterInfo> ParameterList{
 };
 // clang-format on
 
+// Linear scan, so resolve once at setup time and hold on to the index
+inline int parameterListIndexOf(const std::string &paramId)
+{
+    for (size_t i = 0; i < ParameterList.size(); ++i)
+    {
+        if (ParameterList[i].ID.toStdString() == paramId)
+        {
+            return static_cast<int>(i);
+        }
+    }
+
+    return -1;
+}
+
 #endif // OBXF_SRC_PARAMETER_PARAMETERLIST_H
@@ -20,6 +20,36 @@
 #include "SynthParam.h"
 #include "ObxfProcessor.h"
 
+#include <thread>
+
+namespace
+{
+// how many callback tables this thread is reading, see publishCallbacks
+thread_local int callbackReadDepth{0};
+} // namespace
+
+struct ParameterUpdateHandler::CallbackReader
+{
+    const ParameterUpdateHandler &handler;
+    const CallbackTable *table{nullptr};
+
+    explicit CallbackReader(const ParameterUpdateHandler &h) : handler(h)
+    {
+        // count ourselves in before looking, so a publisher can't miss us
+        handler.callbackReaders.fetch_add(1, std::memory_order_seq_cst);
+        ++callbackReadDepth;
+        table = handler.callbackTable.load(std::memory_order_seq_cst);
+    }
+
+    ~CallbackReader()
+    {
+        --callbackReadDepth;
+        handler.callbackReaders.fetch_sub(1, std::memory_order_release);
+    }
+
+    JUCE_DECLARE_NON_COPYABLE(CallbackReader)
+};
+
 ParameterUpdateHandler::ParameterUpdateHandler(ObxfAudioProcessor &audioProcessor,
                                                const std::vector<ParameterInfo> &_parameters)
     : parameters{_parameters}, audioProcessor{audioProcessor}
@@ -64,6 +94,16 @@ ParameterUpdateHandler::ParameterUpdateHandler(ObxfAudioProcessor &audioProcesso
 
     audioProcessor.addParameterGroup(std::move(root));
 
+    for (size_t i = 0; i < indexToID.size(); ++i)
+    {
+        queuedIDToIndex[std::string_view(indexToID[i].toRawUTF8())] = i;
+    }
+
+    {
+        const std::lock_guard<std::mutex> eg(callbackEditLock);
+        publishCallbacks();
+    }
+
     for (auto &p : paramMap)
     {
         if (p.first.toStdString() == SynthParam::ID::LFO1Rate)
@@ -81,12 +121,61 @@ ParameterUpdateHandler::ParameterUpdateHandler(ObxfAudioProcessor &audioProcesso
 
 ParameterUpdateHandler::~ParameterUpdateHandler()
 {
-    std::lock_guard<std::mutex> cblg(callbackMutex);
+    const std::lock_guard<std::mutex> eg(callbackEditLock);
+
+    delete callbackTable.exchange(nullptr);
+    retiredTables.clear();
 
     paramMap.clear();
     callbacks.clear();
 }
 
+void ParameterUpdateHandler::publishCallbacks()
+{
+    auto next = std::make_unique<CallbackTable>();
+    next->entries.resize(indexToID.size());
+
+    for (size_t i = 0; i < indexToID.size(); ++i)
+    {
+        next->entries[i].ID = indexToID[i];
+        next->entries[i].param = getParameter(indexToID[i]);
+        next->byID[indexToID[i]] = i;
+    }
+
+    for (const auto &[id, byPurpose] : callbacks)
+    {
+        auto [it, added] = next->byID.try_emplace(id, next->entries.size());
+
+        if (added)
+        {
+            next->entries.push_back({id, getParameter(id), {}});
+        }
+
+        for (const auto &[purpose, cb] : byPurpose)
+        {
+            next->entries[it->second].fns.push_back(cb);
+            next->entries[it->second].purposes.push_back(purpose);
+        }
+    }
+
+    retiredTables.emplace_back(callbackTable.exchange(next.release(), std::memory_order_seq_cst));
+
+    // Whoever reads from now on sees the new table, so once nobody is reading the old
+    // ones are free. A callback which itself edits callbacks is one of those readers, and
+    // leaves them for the next publish
+    if (callbackReadDepth > 0)
+    {
+        return;
+    }
+
+    while (callbackReaders.load(std::memory_order_seq_cst) != 0)
+    {
+        std::this_thread::yield();
+    }
+
+    retiredTables.clear();
+}
+
 void ParameterUpdateHandler::parameterValueChanged(int parameterIndex, float newValue)
 {
     const auto paramID = indexToID[parameterIndex];
@@ -105,8 +194,9 @@ bool ParameterUpdateHandler::addParameterCallback(const juce::String &ID,
             usePurpose = "unk";
         }
         {
-            std::lock_guard<std::mutex> cblg(callbackMutex);
+            const std::lock_guard<std::mutex> eg(callbackEditLock);
             callbacks[ID][purpose] = cb;
+            publishCallbacks();
         }
         return true;
     }
@@ -117,7 +207,7 @@ bool ParameterUpdateHandler::addParameterCallback(const juce::String &ID,
 bool ParameterUpdateHandler::removeParameterCallback(const juce::String &ID,
                                                      const juce::String &purpose)
 {
-    std::lock_guard<std::mutex> cblg(callbackMutex);
+    const std::lock_guard<std::mutex> eg(callbackEditLock);
 
     auto cbit = callbacks.find(ID);
     if (cbit != callbacks.end())
@@ -126,6 +216,7 @@ bool ParameterUpdateHandler::removeParameterCallback(const juce::String &ID,
         if (purpit != cbit->second.end())
         {
             cbit->second.erase(purpit);
+            publishCallbacks();
         }
     }
     return true;
@@ -133,49 +224,78 @@ bool ParameterUpdateHandler::removeParameterCallback(const juce::String &ID,
 
 void ParameterUpdateHandler::updateParameters(const bool force)
 {
-    if (force)
+    const CallbackReader reader(*this);
+
+    if (!reader.table)
     {
-        std::lock_guard<std::mutex> cblg(callbackMutex);
+        return;
+    }
 
-        std::for_each(callbacks.begin(), callbacks.end(), [this](auto &p) {
-            if (auto *param = getParameter(p.first))
+    if (force)
+    {
+        for (const auto &entry : reader.table->entries)
+        {
+            if (entry.param && !entry.fns.empty())
             {
-                float value = param->getValue();
+                float value = entry.param->getValue();
 
-                OBLOG(paramSet, "FORCE: " << p.first << "=" << value);
-                for (auto &[_, cb] : p.second)
+                OBLOG(paramSet, "FORCE: " << entry.ID << "=" << value);
+                for (const auto &cb : entry.fns)
                     cb(value, true);
             }
-        });
+        }
     }
 
     auto newParam = fifo.popParameter();
     while (newParam.first)
     {
-        std::lock_guard<std::mutex> cblg(callbackMutex);
-
-        if (auto it = callbacks.find(newParam.second.parameterID); it != callbacks.end())
+        if (std::strcmp(newParam.second.parameterID, patchChangeID) == 0)
         {
-            if (/* auto par = */ getParameter(newParam.second.parameterID))
+            if (onPatchChange)
             {
-                OBLOG(paramSet, "UPDATE " << newParam.second.parameterID << " = "
-                                          << newParam.second.newValue);
-                for (auto &[_, cb] : it->second)
-                    cb(newParam.second.newValue, false);
+                onPatchChange();
             }
+
+            newParam = fifo.popParameter();
+            continue;
+        }
+
+        const auto queued = queuedIDToIndex.find(newParam.second.parameterID);
+
+        if (queued == queuedIDToIndex.end())
+        {
+            newParam = fifo.popParameter();
+            continue;
+        }
+
+        if (const auto &entry = reader.table->entries[queued->second]; entry.param)
+        {
+            OBLOG(paramSet, "UPDATE " << newParam.second.parameterID << " = "
+                                      << newParam.second.newValue);
+            for (const auto &cb : entry.fns)
+                cb(newParam.second.newValue, false);
         }
         newParam = fifo.popParameter();
     }
 }
 
 void ParameterUpdateHandler::forceSingleParameterCallback(const juce::String &paramID,
-                                                          float newValue)
+                                                          float newValue,
+                                                          const juce::String &purpose)
 {
-    std::lock_guard<std::mutex> cblg(callbackMutex);
+    const CallbackReader reader(*this);
+
+    if (!reader.table)
+        return;
+
+    if (const auto it = reader.table->byID.find(paramID); it != reader.table->byID.end())
+    {
+        const auto &entry = reader.table->entries[it->second];
 
-    if (auto it = callbacks.find(paramID); it != callbacks.end())
-        for (auto &[_, cb] : it->second)
-            cb(newValue, true);
+        for (size_t i = 0; i < entry.fns.size(); ++i)
+            if (purpose.isEmpty() || entry.purposes[i] == purpose)
+                entry.fns[i](newValue, true);
+    }
 }
 
 juce::RangedAudioParameter *ParameterUpdateHandler::getParameter(const juce::String &paramID) const
@@ -190,11 +310,16 @@ void ParameterUpdateHandler::queueParameterChange(const juce::String &paramID, f
     fifo.pushParameter(paramID, newValue);
 }
 
+void ParameterUpdateHandler::queuePatchChange() { fifo.pushParameter(patchChangeID, 0.f); }
+
 void ParameterUpdateHandler::addParameter(const juce::String &paramID,
                                           juce::RangedAudioParameter *param)
 {
     OBLOG(params, "Adding param to param map : " << paramID);
+
+    const std::lock_guard<std::mutex> eg(callbackEditLock);
     paramMap[paramID] = param;
+    publishCallbacks();
 }
 
 void ParameterUpdateHandler::parameterGestureChanged(int idx, bool b)
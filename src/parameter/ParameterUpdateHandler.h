@@ -26,9 +26,14 @@
 #include "ParameterInfo.h"
 #include "FIFO.h"
 
-#include <unordered_map>
+#include <atomic>
 #include <deque>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 class ObxfAudioProcessor;
 
@@ -67,6 +72,14 @@ class ParameterUpdateHandler : public juce::AudioProcessorParameter::Listener
     // This pushes a change onto the engine FIFO from the nonaudio thread
     void queueParameterChange(const juce::String &paramID, float newValue);
 
+    /*
+     * Queues a patch change marker ahead of the new patch's values. updateParameters calls
+     * onPatchChange when it gets to the marker, so the audio thread sees the change exactly
+     * between the last value of the old patch and the first of the new one.
+     */
+    void queuePatchChange();
+    std::function<void()> onPatchChange;
+
     void clearFIFO();
     bool isFIFOClear();
 
@@ -74,11 +87,13 @@ class ParameterUpdateHandler : public juce::AudioProcessorParameter::Listener
     void updateParameters(bool force = false);
 
     /**
-     * This function is used only by the MIDI lag handler which runs on audio thread
-     * so is a shortcut around the FIFO for that use case. Don't use it unless
+     * This function is used only by the MIDI lag handler, to bring the UI along with a
+     * value it has already put into the engine, so is a shortcut around the FIFO for that
+     * use case. With a purpose, only that purpose's callback runs. Don't use it unless
      * you know why you want to use it.
      */
-    void forceSingleParameterCallback(const juce::String &paramID, float newValue);
+    void forceSingleParameterCallback(const juce::String &paramID, float newValue,
+                                      const juce::String &purpose = {});
 
     juce::RangedAudioParameter *getParameter(const juce::String &paramID) const;
     void addParameter(const juce::String &paramID, juce::RangedAudioParameter *param);
@@ -89,22 +104,55 @@ class ParameterUpdateHandler : public juce::AudioProcessorParameter::Listener
     void redo();
 
   private:
+    // never a parameter ID, see queuePatchChange
+    static constexpr const char *patchChangeID{"#patch-change"};
+
     FIFO<128> fifo;
     std::vector<ParameterInfo> parameters;
     ObxfAudioProcessor &audioProcessor;
 
+    // the callbacks as added, by ID and purpose; only touched with callbackEditLock held
     std::unordered_map<juce::String, std::unordered_map<juce::String, callbackFn_t>> callbacks;
     std::unordered_map<juce::String, juce::RangedAudioParameter *> paramMap;
     std::vector<juce::String> indexToID;
+    // views into indexToID, so the audio thread finds a queued ID without making a String
+    std::unordered_map<std::string_view, size_t> queuedIDToIndex;
 
     std::deque<std::pair<juce::String, float>> undoStack;
 
+    struct CallbackEntry
+    {
+        juce::String ID;
+        juce::RangedAudioParameter *param{nullptr};
+        std::vector<callbackFn_t> fns;
+        // the purpose each of fns was added for
+        std::vector<juce::String> purposes;
+    };
+
     /*
-     * Note we have a mutex to lock callbacks but it is almost never contested.
-     * The only reason we need it is if editor closes during VST automation the closing
-     * editor will modify the callback structure to remove its hooks
+     * What the callers of the callbacks read: an immutable copy of callbacks, in indexToID
+     * order followed by any other IDs. Adding or removing a callback (say, an editor
+     * building or dropping its attachments) builds a new table under callbackEditLock and
+     * swaps it in, so the audio thread never takes a lock and never waits on a thread
+     * which is allocating. The old table is freed once no reader is left in it, which also
+     * means an editor's callbacks have stopped running by the time removal returns.
      */
-    std::mutex callbackMutex;
+    struct CallbackTable
+    {
+        std::vector<CallbackEntry> entries;
+        std::unordered_map<juce::String, size_t> byID;
+    };
+
+    struct CallbackReader;
+
+    // call with callbackEditLock held
+    void publishCallbacks();
+
+    std::mutex callbackEditLock;
+    std::atomic<const CallbackTable *> callbackTable{nullptr};
+    mutable std::atomic<int> callbackReaders{0};
+    // tables swapped out while the publishing thread was itself reading one
+    std::vector<std::unique_ptr<const CallbackTable>> retiredTables;
 
     bool supressGestureToUndo{false};
 
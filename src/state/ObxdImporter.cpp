@@ -20,9 +20,15 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cmath>
+#include <condition_variable>
 #include <cstdint>
 #include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 
 #include <juce_audio_processors/juce_audio_processors.h>
 
@@ -169,7 +175,6 @@ float mapLfoSyncedRate(float vXd)
 
 void seedDefaults(Program &program)
 {
-    program.values.clear();
     for (const auto &param : ParameterList)
     {
         program.values[param.ID] = param.meta.naturalToNormalized01(param.meta.defaultVal);
@@ -660,64 +665,316 @@ bool ObxdImporter::importSingleOnto(const void *data, size_t size, Program &outP
     return wrote;
 }
 
-ObxdImporter::BankImportResult ObxdImporter::importBankFromFxb(
-    const void *data, size_t size, const juce::String &bankName, const juce::File &destFolder,
-    const std::function<bool(const Program &, juce::MemoryBlock &)> &serializePatch)
+namespace
+{
+
+// Bounded queue between the stages of a bank import. Once closed, pushes fail and pops
+// drain whatever is left; abort() also throws away what is left.
+template <typename T> class ImportQueue
+{
+  public:
+    explicit ImportQueue(size_t cap) : capacity(cap) {}
+
+    bool push(T &&item)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        notFull.wait(lock, [this]() { return closed || items.size() < capacity; });
+
+        if (closed)
+        {
+            return false;
+        }
+
+        items.push_back(std::move(item));
+        notEmpty.notify_one();
+
+        return true;
+    }
+
+    // waits for at least one item, then takes up to maxItems
+    bool pop(std::vector<T> &out, size_t maxItems)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        notEmpty.wait(lock, [this]() { return closed || !items.empty(); });
+
+        while (!items.empty() && out.size() < maxItems)
+        {
+            out.push_back(std::move(items.front()));
+            items.pop_front();
+        }
+
+        notFull.notify_all();
+
+        return !out.empty();
+    }
+
+    void close()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        closed = true;
+        notEmpty.notify_all();
+        notFull.notify_all();
+    }
+
+    void abort()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        closed = true;
+        items.clear();
+        notEmpty.notify_all();
+        notFull.notify_all();
+    }
+
+  private:
+    const size_t capacity;
+    std::deque<T> items;
+    bool closed{false};
+
+    std::mutex mutex;
+    std::condition_variable notEmpty, notFull;
+};
+
+struct BankSource
+{
+    juce::String name;
+    juce::File file;
+    const void *data{nullptr};
+    size_t size{0};
+};
+
+struct ProgramJob
+{
+    int bank{0};
+    int program{0};
+    std::unique_ptr<juce::XmlElement> xml;
+};
+
+struct TranslatedPatch
 {
-    BankImportResult result;
+    int bank{0};
+    int program{0};
+    juce::String fileName;
+    juce::MemoryBlock fxp;
+};
+
+ObxdImporter::BankImportResult
+runBankImport(const std::vector<BankSource> &banks, const juce::File &destFolder,
+              const std::function<bool(const Program &, juce::MemoryBlock &)> &serializePatch,
+              const ObxdImporter::BankImportOptions &options)
+{
+    ObxdImporter::BankImportResult result;
+
+    const auto numCores = static_cast<int>(std::thread::hardware_concurrency());
+    const auto numWorkers = options.numWorkers > 0 ? options.numWorkers : std::max(1, numCores);
+    const auto batchSize = static_cast<size_t>(std::max(1, options.writeBatchSize));
 
-    const juce::File bankFolder = destFolder.getChildFile(bankName);
+    ImportQueue<ProgramJob> jobs(static_cast<size_t>(numWorkers) * 4);
+    ImportQueue<TranslatedPatch> translated(batchSize * 2);
 
-    bool visitOk = visitPrograms(
-        data, size, [&](int /*idx*/, bool /*isCurrent*/, const juce::XmlElement &programEl) {
-            // Check for init patch by name before translating
-            const juce::String programName = programEl.getStringAttribute("programName", "Default");
+    std::atomic<bool> cancelled{false};
+    std::atomic<int> banksRead{0}, patchesRead{0};
+    int skipped{0}, failedBanks{0};
 
-            if (programName.trim().equalsIgnoreCase("Default"))
+    // Reader: one bank in memory at a time, its programs handed out as they are visited
+    std::thread reader([&]() {
+        for (size_t b = 0; b < banks.size() && !cancelled; ++b)
+        {
+            const auto &bank = banks[b];
+            juce::MemoryBlock fileData;
+            const void *data = bank.data;
+            auto size = bank.size;
+
+            if (!data)
             {
-                ++result.skipped;
-                return;
+                if (!bank.file.loadFileAsData(fileData))
+                {
+                    ++failedBanks;
+                    ++banksRead;
+                    continue;
+                }
+
+                data = fileData.getData();
+                size = fileData.getSize();
             }
 
-            Program prog;
-            std::vector<std::string> warnings;
-            translateProgramFromXml(programEl, prog, warnings);
+            const bool ok = ObxdImporter::visitPrograms(
+                data, size, [&](int idx, bool /*isCurrent*/, const juce::XmlElement &programEl) {
+                    if (cancelled)
+                    {
+                        return;
+                    }
+
+                    // Check for init patch by name before translating
+                    const auto programName = programEl.getStringAttribute("programName", "Default");
 
-            // Override the project metadata with the bank name
-            prog.setProject(bankName);
+                    if (programName.trim().equalsIgnoreCase("Default"))
+                    {
+                        ++skipped;
+                        return;
+                    }
 
-            juce::MemoryBlock mb;
-            if (!serializePatch(prog, mb))
+                    ++patchesRead;
+                    jobs.push({static_cast<int>(b), idx,
+                               std::make_unique<juce::XmlElement>(programEl)});
+                });
+
+            if (!ok)
             {
-                // serialization failure — treat as a skip but don't count as skipping an init patch
-                return;
+                ++failedBanks;
             }
 
-            // Sanitize patch name for use as a filename.
-            juce::String safeName = prog.getName().replaceCharacters("\\/:*?\"<>|", " ").trim();
+            ++banksRead;
+        }
 
-            if (safeName.isEmpty())
+        jobs.close();
+    });
+
+    // Workers: translate and serialize
+    std::atomic<int> workersLeft{numWorkers};
+    std::vector<std::thread> workers;
+
+    for (int w = 0; w < numWorkers; ++w)
+    {
+        workers.emplace_back([&]() {
+            std::vector<ProgramJob> batch;
+
+            while (jobs.pop(batch, 1))
+            {
+                auto &job = batch.front();
+
+                Program prog;
+                std::vector<std::string> warnings;
+                ObxdImporter::translateProgramFromXml(*job.xml, prog, warnings);
+
+                // Override the project metadata with the bank name
+                prog.setProject(banks[job.bank].name);
+
+                TranslatedPatch patch;
+                patch.bank = job.bank;
+                patch.program = job.program;
+
+                // a serialization failure is dropped, but isn't counted as skipping an init patch
+                if (serializePatch(prog, patch.fxp))
+                {
+                    // Sanitize patch name for use as a filename.
+                    patch.fileName =
+                        prog.getName().replaceCharacters("\\/:*?\"<>|", " ").trim();
+
+                    if (patch.fileName.isEmpty())
+                    {
+                        patch.fileName = juce::String("Patch ") + juce::String(job.program + 1);
+                    }
+
+                    translated.push(std::move(patch));
+                }
+
+                batch.clear();
+            }
+
+            if (--workersLeft == 0)
             {
-                safeName = juce::String("Patch ") + juce::String(result.imported + 1);
+                translated.close();
             }
+        });
+    }
 
-            const juce::File patchFile = bankFolder.getChildFile(safeName + ".fxp");
+    // Writer: the calling thread. Programs may come back out of order, so remember which
+    // program each file was last written from to keep the later one of any duplicates.
+    std::unordered_map<juce::String, int> writtenFrom;
+    std::vector<TranslatedPatch> batch;
+    ObxdImporter::BankImportProgress progress;
+    progress.banksTotal = static_cast<int>(banks.size());
+
+    while (translated.pop(batch, batchSize))
+    {
+        for (const auto &patch : batch)
+        {
+            const auto bankFolder = destFolder.getChildFile(banks[patch.bank].name);
+            const auto patchFile = bankFolder.getChildFile(patch.fileName + ".fxp");
+            const auto path = patchFile.getFullPathName();
+
+            if (const auto it = writtenFrom.find(path);
+                it != writtenFrom.end() && it->second > patch.program)
+            {
+                // a serial import would have written this one first and then overwritten it
+                ++result.imported;
+                continue;
+            }
 
             if (!bankFolder.createDirectory())
             {
-                return;
+                continue;
             }
 
-            if (patchFile.replaceWithData(mb.getData(), mb.getSize()))
+            if (patchFile.replaceWithData(patch.fxp.getData(), patch.fxp.getSize()))
             {
+                writtenFrom[path] = patch.program;
                 ++result.imported;
             }
-        });
+        }
+
+        progress.patchesWritten += static_cast<int>(batch.size());
+        batch.clear();
 
-    if (!visitOk)
+        if (options.progress)
+        {
+            progress.banksRead = banksRead;
+            progress.patchesRead = patchesRead;
+            options.progress(progress);
+        }
+
+        if (options.shouldCancel && options.shouldCancel())
+        {
+            cancelled = true;
+            jobs.abort();
+            translated.abort();
+        }
+    }
+
+    reader.join();
+
+    for (auto &w : workers)
     {
-        result.parseError = true;
+        w.join();
     }
 
+    result.skipped = skipped;
+    result.failedBanks = failedBanks;
+    result.parseError = failedBanks > 0;
+    result.cancelled = cancelled;
+
     return result;
 }
+
+} // namespace
+
+ObxdImporter::BankImportResult ObxdImporter::importBankFromFxb(
+    const void *data, size_t size, const juce::String &bankName, const juce::File &destFolder,
+    const std::function<bool(const Program &, juce::MemoryBlock &)> &serializePatch)
+{
+    BankSource bank;
+    bank.name = bankName;
+    bank.data = data;
+    bank.size = size;
+
+    return runBankImport({bank}, destFolder, serializePatch, {});
+}
+
+ObxdImporter::BankImportResult ObxdImporter::importBanks(
+    const std::vector<juce::File> &fxbFiles, const juce::File &destFolder,
+    const std::function<bool(const Program &, juce::MemoryBlock &)> &serializePatch,
+    const BankImportOptions &options)
+{
+    std::vector<BankSource> banks;
+    banks.reserve(fxbFiles.size());
+
+    for (const auto &f : fxbFiles)
+    {
+        BankSource bank;
+        bank.name = f.getFileNameWithoutExtension();
+        bank.file = f;
+        banks.push_back(std::move(bank));
+    }
+
+    return runBankImport(banks, destFolder, serializePatch, options);
+}
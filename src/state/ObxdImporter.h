@@ -61,6 +61,41 @@ class ObxdImporter
         int imported{0}; // number of patches written to disk
         int skipped{0};  // number of "Default" (init) patches skipped
         bool parseError{false};
+        int failedBanks{0}; // banks which could not be read or parsed
+        bool cancelled{false};
+    };
+
+    // Progress of a bank import, as seen by the thread writing the patches.
+    struct BankImportProgress
+    {
+        int banksTotal{0};
+        int banksRead{0};
+        int patchesRead{0};
+        int patchesWritten{0};
+
+        double fraction() const
+        {
+            if (banksTotal == 0)
+            {
+                return 1.0;
+            }
+
+            const double written = patchesRead > 0 ? double(patchesWritten) / patchesRead : 1.0;
+
+            return written * banksRead / banksTotal;
+        }
+    };
+
+    struct BankImportOptions
+    {
+        // worker threads translating and serializing programs, 0 for one per core
+        int numWorkers{0};
+        // patches are written out in batches of this many
+        int writeBatchSize{32};
+
+        // both are called on the calling thread, between write batches
+        std::function<void(const BankImportProgress &)> progress;
+        std::function<bool()> shouldCancel;
     };
 
     // Import every non-default program from an OB-Xd FXB onto disk.
@@ -72,6 +107,16 @@ class ObxdImporter
     static BankImportResult importBankFromFxb(
         const void *data, size_t size, const juce::String &bankName, const juce::File &destFolder,
         const std::function<bool(const Program &, juce::MemoryBlock &)> &serializePatch);
+
+    // Import many FXB files, each into `destFolder/<fxb file name>/`. Banks are read and
+    // parsed one at a time on a reader thread, their programs are translated and serialized
+    // on a pool of workers, and the calling thread writes the results in batches. So
+    // `serializePatch` must be safe to call from several threads at once. When one bank has
+    // several programs of the same name, the last of them wins, as with a serial import.
+    static BankImportResult importBanks(
+        const std::vector<juce::File> &fxbFiles, const juce::File &destFolder,
+        const std::function<bool(const Program &, juce::MemoryBlock &)> &serializePatch,
+        const BankImportOptions &options = {});
 };
 
 #endif // OBXF_SRC_STATE_OBXDIMPORTER_H
@@ -0,0 +1,147 @@
+/*
+ * OB-Xd was originally written by Vadim Filatov, and then a version
+ * was released under the GPL3 at https://github.com/reales/OB-Xd.
+ * Subsequently, the product was continued by DiscoDSP and the copyright
+ * holders as an excellent closed source product.
+ *
+ * This repository is a successor to OB-Xd version 2.11.
+ * Copyright 2013-2025 by the authors as indicated in the original release,
+ * and subsequent authors as per GitHub transaction log.
+ *
+ * OB-Xf is released under the GNU General Public Licence v3 or later
+ * (GPL-3.0-or-later). The license is found in the file "LICENSE"
+ * in the root of this repository or at:
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * Source code is available at https://github.com/surge-synthesizer/OB-Xf
+ */
+
+#ifndef OBXF_SRC_STATE_PREPAREDPROGRAM_H
+#define OBXF_SRC_STATE_PREPAREDPROGRAM_H
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "Program.h"
+#include "VoiceMatrix.h"
+
+/*
+ * A PreparedProgram is a patch which has already been read and decoded into a dense
+ * value vector in ParameterList order plus its matrix rows. Applying one needs no file
+ * I/O, no XML and no string keyed lookups, so it is safe to do from the audio thread.
+ */
+struct PreparedProgram
+{
+    int patchIndex{-1};
+
+    std::vector<float> values;
+    std::array<MatrixRow, NUM_MATRIX_ROWS> matrixRows{};
+
+    juce::String name, author, license, category, project;
+
+    void setFrom(const Program &program, const VoiceMatrix &matrix)
+    {
+        values.resize(ParameterList.size());
+
+        for (size_t i = 0; i < ParameterList.size(); ++i)
+        {
+            values[i] = program.getValueById(ParameterList[i].ID);
+        }
+
+        matrixRows = matrix.rows;
+
+        name = program.getName();
+        author = program.getAuthor();
+        license = program.getLicense();
+        category = program.getCategory();
+        project = program.getProject();
+    }
+};
+
+/*
+ * An immutable set of PreparedPrograms which the message thread publishes and the audio
+ * thread reads with a single atomic load. The programs themselves are decoded once on the
+ * patch scan thread and shared by every instance (see SharedPatchTree). Since the audio
+ * thread never takes a reference count, we retain the last few generations rather than
+ * dropping a bank the moment it is replaced; banks are only republished on a patch rescan
+ * so this is plenty.
+ * A generation holding a program the audio thread has applied but the message thread has
+ * not yet taken (see markApplied) is never freed, however many rescans come in between.
+ */
+class PreparedProgramBank
+{
+  public:
+    using programs_t = std::vector<PreparedProgram>;
+
+    void publish(programs_t &&programs)
+    {
+        publish(std::make_shared<const programs_t>(std::move(programs)));
+    }
+
+    void publish(std::shared_ptr<const programs_t> next)
+    {
+        if (!next || next.get() == current.load(std::memory_order_relaxed))
+        {
+            return;
+        }
+
+        current.store(next.get(), std::memory_order_release);
+
+        generations.push_back(std::move(next));
+
+        const auto *pending = applied.load(std::memory_order_acquire);
+        while (generations.size() > retainedGenerations && !holds(*generations.front(), pending))
+        {
+            generations.pop_front();
+        }
+    }
+
+    const PreparedProgram *get(const int idx) const
+    {
+        const auto *programs = current.load(std::memory_order_acquire);
+
+        if (!programs || idx < 0 || idx >= static_cast<int>(programs->size()))
+        {
+            return nullptr;
+        }
+
+        return &(*programs)[idx];
+    }
+
+    size_t size() const
+    {
+        const auto *programs = current.load(std::memory_order_acquire);
+        return programs ? programs->size() : 0;
+    }
+
+    // Audio thread: hands a program it has applied over to the message thread
+    void markApplied(const PreparedProgram *prog)
+    {
+        applied.store(prog, std::memory_order_release);
+    }
+
+    // Message thread: the program applied since the last call, valid until the next publish
+    const PreparedProgram *takeApplied()
+    {
+        return applied.exchange(nullptr, std::memory_order_acq_rel);
+    }
+
+  private:
+    static constexpr size_t retainedGenerations{4};
+
+    static bool holds(const programs_t &programs, const PreparedProgram *prog)
+    {
+        const std::less<const PreparedProgram *> before;
+        return prog && !before(prog, programs.data()) &&
+               before(prog, programs.data() + programs.size());
+    }
+
+    std::atomic<const programs_t *> current{nullptr};
+    std::atomic<const PreparedProgram *> applied{nullptr};
+    std::deque<std::shared_ptr<const programs_t>> generations;
+};
+
+#endif // OBXF_SRC_STATE_PREPAREDPROGRAM_H
@@ -20,33 +20,180 @@
 #include "ObxdImporter.h"
 #include "ObxfProcessor.h"
 
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
 template <typename T> juce::String S(const T &text) { return juce::String(text); }
 
+namespace
+{
+/*
+ * Binary plugin state. Everything is little endian, as written by juce::MemoryOutputStream:
+ *
+ *   "OBXB" | int32 format version | int64 streaming version | int32 parameter layout hash
+ *   int32 N | N x float32 values in ParameterList order | N x int32 parameter ID hashes
+ *   program name, author, license, category, project as UTF-8 strings
+ *   int32 M | M x (int32 row index, source string, target string, float32 depth)
+ *   DAW extra state, see DAWExtraState::toStream()
+ *
+ * When the layout hash matches ours the values are taken as they lie; otherwise each
+ * value is matched up through its ID hash, so reordered or added parameters still load.
+ */
+constexpr char binaryStateMagic[4] = {'O', 'B', 'X', 'B'};
+constexpr int binaryStateVersion{1};
+constexpr int maxBinaryStateParameters{4096};
+
+uint32_t hashParameterID(const juce::String &id)
+{
+    // FNV-1a
+    uint32_t h{2166136261u};
+
+    for (auto *c = id.toRawUTF8(); *c; ++c)
+    {
+        h = (h ^ static_cast<uint8_t>(*c)) * 16777619u;
+    }
+
+    return h;
+}
+
+const std::vector<uint32_t> &parameterIDHashes()
+{
+    static const std::vector<uint32_t> hashes = [] {
+        std::vector<uint32_t> res;
+        res.reserve(ParameterList.size());
+
+        for (const auto &param : ParameterList)
+        {
+            res.push_back(hashParameterID(param.ID));
+        }
+
+        return res;
+    }();
+
+    return hashes;
+}
+
+uint32_t parameterLayoutHash()
+{
+    static const uint32_t layoutHash = [] {
+        uint32_t h{2166136261u};
+
+        for (auto idHash : parameterIDHashes())
+        {
+            h = (h ^ idHash) * 16777619u;
+        }
+
+        return h;
+    }();
+
+    return layoutHash;
+}
+
+bool isBinaryState(const void *data, int sizeInBytes)
+{
+    return data && sizeInBytes >= static_cast<int>(sizeof(binaryStateMagic)) &&
+           std::memcmp(data, binaryStateMagic, sizeof(binaryStateMagic)) == 0;
+}
+
+/*
+ * An exhausted stream reads as zero rather than failing, so members appended to the DAW
+ * extra state in later versions are only read when their bytes are actually there.
+ */
+void readAppended(juce::InputStream &in, bool &v)
+{
+    if (in.getNumBytesRemaining() >= 1)
+    {
+        v = in.readBool();
+    }
+}
+
+void readAppended(juce::InputStream &in, uint8_t &v)
+{
+    if (in.getNumBytesRemaining() >= 1)
+    {
+        v = static_cast<uint8_t>(in.readByte());
+    }
+}
+
+void readAppended(juce::InputStream &in, int &v)
+{
+    if (in.getNumBytesRemaining() >= 4)
+    {
+        v = in.readInt();
+    }
+}
+
+void readAppended(juce::InputStream &in, float &v)
+{
+    if (in.getNumBytesRemaining() >= 4)
+    {
+        v = in.readFloat();
+    }
+}
+} // namespace
+
 StateManager::~StateManager() = default;
 
+bool StateManager::isPluginState(const void *data, int sizeInBytes)
+{
+    if (isBinaryState(data, sizeInBytes))
+    {
+        return true;
+    }
+
+    const auto xml = ObxfAudioProcessor::getXmlFromBinary(data, sizeInBytes);
+
+    return xml && xml->getChildByName("program") != nullptr;
+}
+
 void StateManager::getPluginStateInformation(juce::MemoryBlock &destData) const
 {
     OBLOG(state, "GetStateInformation");
 
-    auto xmlState = juce::XmlElement("OB-Xf");
+    const Program &prog = audioProcessor->getActiveProgram();
+    juce::MemoryOutputStream out(destData, false);
 
-    xmlState.setAttribute(S("ob-xf_version"), humanReadableVersion(currentStreamingVersion));
-    xmlState.setAttribute(S("single-program-format"), 1);
+    out.write(binaryStateMagic, sizeof(binaryStateMagic));
+    out.writeInt(binaryStateVersion);
+    out.writeInt64(static_cast<juce::int64>(currentStreamingVersion));
+    out.writeInt(static_cast<int>(parameterLayoutHash()));
+    out.writeInt(static_cast<int>(ParameterList.size()));
+
+    for (const auto &param : ParameterList)
     {
-        auto *xpr = new juce::XmlElement("program");
-        getActiveProgramStateOnto(*xpr);
-        xmlState.addChildElement(xpr);
+        out.writeFloat(prog.getValueById(param.ID));
     }
 
-    auto des = dawExtraState.toElement();
-    if (des)
+    for (auto idHash : parameterIDHashes())
     {
-        auto *desp = new juce::XmlElement("dawExtraState");
-        desp->addChildElement(des.release());
-        xmlState.addChildElement(desp);
+        out.writeInt(static_cast<int>(idHash));
     }
 
-    juce::AudioProcessor::copyXmlToBinary(xmlState, destData);
+    out.writeString(prog.getName());
+    out.writeString(prog.getAuthor());
+    out.writeString(prog.getLicense());
+    out.writeString(prog.getCategory());
+    out.writeString(prog.getProject());
+
+    const auto &rows = audioProcessor->getSynth().getMotherboard()->voiceMatrix.rows;
+    const auto activeRows = std::count_if(rows.begin(), rows.end(),
+                                          [](const auto &row) { return row.isActive(); });
+
+    out.writeInt(static_cast<int>(activeRows));
+
+    for (int i = 0; i < NUM_MATRIX_ROWS; ++i)
+    {
+        if (rows[i].isActive())
+        {
+            out.writeInt(i);
+            out.writeString(matrixSourceToString(rows[i].source));
+            out.writeString(matrixTargetToString(rows[i].target));
+            out.writeFloat(rows[i].depth);
+        }
+    }
+
+    dawExtraState.toStream(out);
 }
 
 void StateManager::getProgramStateInformation(juce::MemoryBlock &destData) const
@@ -149,21 +296,127 @@ void StateManager::populateProgramFromXml(Program &program, const juce::XmlEleme
             value *= 0.25f;
         }
 
-        // Legacy version mapping
-        if (versionNumber < 0x2025'12'13)
+        program.values[paramId] = migrateParameterValue(paramId, value, versionNumber);
+    }
+
+    applyParameterLocks(program);
+
+    // Populate Metadata
+    program.setName(e.getStringAttribute("programName", "Init"));
+    program.setAuthor(e.getStringAttribute("author", ""));
+    program.setLicense(e.getStringAttribute("license", ""));
+    program.setCategory(e.getStringAttribute("category", ""));
+    program.setProject(e.getStringAttribute("project", ""));
+}
+
+bool StateManager::decodeProgram(const juce::MemoryBlock &mb, Program &program,
+                                 VoiceMatrix *matrix)
+{
+    if (ObxdImporter::isOBXdData(mb.getData(), mb.getSize()))
+    {
+        return ObxdImporter::importSingleOnto(mb.getData(), mb.getSize(), program);
+    }
+
+    const void *data = nullptr;
+    int sizeInBytes = 0;
+
+    if (!getChunkFromFxpData(mb.getData(), mb.getSize(), data, sizeInBytes))
+    {
+        return false;
+    }
+
+    const auto e = juce::AudioProcessor::getXmlFromBinary(data, sizeInBytes);
+
+    if (!e)
+    {
+        return false;
+    }
+
+    const auto verNo =
+        fromHumanReadableVersion(e->getStringAttribute("ob-xf_version").toStdString());
+    const bool newFormat = e->hasAttribute("voiceCount");
+
+    // as populateProgramFromXml, but over ParameterList rather than an instance's parameters
+    program.setToDefaultPatch();
+
+    for (const auto &param : ParameterList)
+    {
+        auto value = static_cast<float>(e->getDoubleAttribute(param.ID, program.values[param.ID]));
+
+        if (!newFormat && param.ID == "POLYPHONY")
         {
-            if (paramId.compare(SynthParam::ID::UnisonVoices) == 0)
-            {
-                const auto oldVal = juce::jlimit(
-                    0, MAX_PANNINGS - 1, static_cast<int>(std::round(value * (MAX_PANNINGS - 1))));
-                value = static_cast<float>(oldVal) / static_cast<float>(MAX_VOICES - 1);
-            }
+            value *= 0.25f;
         }
 
-        program.values[paramId] = value;
+        program.values[param.ID] = migrateParameterValue(param.ID, value, verNo);
+    }
+
+    program.setName(e->getStringAttribute("programName", "Init"));
+    program.setAuthor(e->getStringAttribute("author", ""));
+    program.setLicense(e->getStringAttribute("license", ""));
+    program.setCategory(e->getStringAttribute("category", ""));
+    program.setProject(e->getStringAttribute("project", ""));
+
+    if (matrix)
+    {
+        matrix->fromElement(e->getChildByName("VoiceMatrix"));
+    }
+
+    return true;
+}
+
+bool StateManager::decodeProgramValues(const juce::MemoryBlock &mb, std::vector<float> &out)
+{
+    Program program;
+
+    if (!decodeProgram(mb, program, nullptr))
+    {
+        return false;
+    }
+
+    out.resize(ParameterList.size());
+
+    for (size_t i = 0; i < ParameterList.size(); ++i)
+    {
+        out[i] = program.getValueById(ParameterList[i].ID);
+    }
+
+    return true;
+}
+
+bool StateManager::decodePreparedProgram(const juce::MemoryBlock &mb, PreparedProgram &prepared)
+{
+    Program program;
+    VoiceMatrix matrix;
+
+    if (!decodeProgram(mb, program, &matrix))
+    {
+        return false;
+    }
+
+    prepared.setFrom(program, matrix);
+    return true;
+}
+
+float StateManager::migrateParameterValue(const juce::String &paramId, float value,
+                                          uint64_t versionNumber)
+{
+    // Legacy version mapping
+    if (versionNumber < 0x2025'12'13)
+    {
+        if (paramId.compare(SynthParam::ID::UnisonVoices) == 0)
+        {
+            const auto oldVal = juce::jlimit(
+                0, MAX_PANNINGS - 1, static_cast<int>(std::round(value * (MAX_PANNINGS - 1))));
+            value = static_cast<float>(oldVal) / static_cast<float>(MAX_VOICES - 1);
+        }
     }
 
-    // handle parameter locks
+    return value;
+}
+
+void StateManager::applyParameterLocks(Program &program) const
+{
     if (audioProcessor->lockHighQuality)
     {
         program.values[ID::HQMode] = static_cast<float>(audioProcessor->lockedHQ);
@@ -176,18 +429,24 @@ void StateManager::populateProgramFromXml(Program &program, const juce::XmlEleme
         program.values[ID::BendUpRange] = static_cast<float>(audioProcessor->lockedPBUpRange) /
                                           static_cast<float>(MAX_BEND_RANGE);
     }
-
-    // Populate Metadata
-    program.setName(e.getStringAttribute("programName", "Init"));
-    program.setAuthor(e.getStringAttribute("author", ""));
-    program.setLicense(e.getStringAttribute("license", ""));
-    program.setCategory(e.getStringAttribute("category", ""));
-    program.setProject(e.getStringAttribute("project", ""));
 }
 
 void StateManager::setPluginStateInformation(const void *data, int sizeInBytes)
 {
     OBLOG(state, "setStateInformation");
+
+    if (isBinaryState(data, sizeInBytes))
+    {
+        if (setPluginStateFromBinary(data, sizeInBytes))
+        {
+            audioProcessor->processActiveProgramChanged();
+            audioProcessor->sendChangeMessage();
+        }
+
+        return;
+    }
+
+    // Sessions saved before the binary format was introduced
     const std::unique_ptr<juce::XmlElement> xmlState =
         ObxfAudioProcessor::getXmlFromBinary(data, sizeInBytes);
 
@@ -222,6 +481,104 @@ void StateManager::setPluginStateInformation(const void *data, int sizeInBytes)
     }
 }
 
+bool StateManager::setPluginStateFromBinary(const void *data, int sizeInBytes)
+{
+    juce::MemoryInputStream in(data, static_cast<size_t>(sizeInBytes), false);
+    in.skipNextBytes(sizeof(binaryStateMagic));
+
+    const auto formatVersion = in.readInt();
+    const auto verNo = static_cast<uint64_t>(in.readInt64());
+    const auto layoutHash = static_cast<uint32_t>(in.readInt());
+    const auto numParams = in.readInt();
+
+    OBLOG(state, "Binary state format " << formatVersion << ", streaming version "
+                                        << humanReadableVersion(verNo));
+
+    if (formatVersion < 1 || numParams < 0 || numParams > maxBinaryStateParameters ||
+        in.getNumBytesRemaining() < static_cast<juce::int64>(numParams) * 8)
+    {
+        OBLOG(state, "Binary state is malformed!");
+        return false;
+    }
+
+    // newer writers may append to the format, but never reorder what we read here
+    std::vector<float> values(static_cast<size_t>(numParams));
+
+    for (auto &v : values)
+    {
+        v = in.readFloat();
+    }
+
+    std::vector<int> storedIndex(ParameterList.size(), -1);
+
+    if (layoutHash == parameterLayoutHash() && static_cast<size_t>(numParams) == storedIndex.size())
+    {
+        in.skipNextBytes(static_cast<juce::int64>(numParams) * 4);
+        std::iota(storedIndex.begin(), storedIndex.end(), 0);
+    }
+    else
+    {
+        const auto &ourHashes = parameterIDHashes();
+
+        for (int i = 0; i < numParams; ++i)
+        {
+            const auto h = static_cast<uint32_t>(in.readInt());
+            const auto it = std::find(ourHashes.begin(), ourHashes.end(), h);
+
+            if (it != ourHashes.end())
+            {
+                storedIndex[static_cast<size_t>(std::distance(ourHashes.begin(), it))] = i;
+            }
+        }
+    }
+
+    auto &program = audioProcessor->getActiveProgram();
+
+    for (size_t i = 0; i < ParameterList.size(); ++i)
+    {
+        const auto &param = ParameterList[i];
+        const auto value = storedIndex[i] >= 0
+                               ? values[static_cast<size_t>(storedIndex[i])]
+                               : param.meta.naturalToNormalized01(param.meta.defaultVal);
+
+        program.values[param.ID] = verNo == currentStreamingVersion
+                                       ? value
+                                       : migrateParameterValue(param.ID, value, verNo);
+    }
+
+    applyParameterLocks(program);
+
+    program.setName(in.readString());
+    program.setAuthor(in.readString());
+    program.setLicense(in.readString());
+    program.setCategory(in.readString());
+    program.setProject(in.readString());
+
+    auto &matrix = audioProcessor->getSynth().getMotherboard()->voiceMatrix;
+    matrix.rows.fill(MatrixRow{});
+
+    const auto numRows = in.readInt();
+
+    for (int r = 0; r < numRows && !in.isExhausted(); ++r)
+    {
+        const auto idx = in.readInt();
+        const auto source = in.readString().toStdString();
+        const auto target = in.readString().toStdString();
+        const auto depth = in.readFloat();
+
+        if (idx >= 0 && idx < NUM_MATRIX_ROWS)
+        {
+            matrix.rows[idx].source = matrixSourceFromString(source);
+            matrix.rows[idx].target = matrixTargetFromString(target);
+            matrix.rows[idx].depth = depth;
+        }
+    }
+
+    dawExtraState.fromStream(in);
+
+    return true;
+}
+
 void StateManager::setProgramStateInformation(const void *data, const int sizeInBytes)
 {
     if (const std::unique_ptr<juce::XmlElement> e =
@@ -340,6 +697,11 @@ void StateManager::collectDAWExtraStateFromInstance()
 
     dawExtraState.lockHQ = audioProcessor->lockHighQuality.load();
     dawExtraState.highQuality = audioProcessor->lockedHQ;
+
+    dawExtraState.patchCrossfade = audioProcessor->patchCrossfade.load();
+
+    dawExtraState.lockSeed = audioProcessor->lockSeed.load();
+    dawExtraState.seed = audioProcessor->getRenderSeed();
 }
 
 void StateManager::applyDAWExtraStateToInstance()
@@ -371,6 +733,17 @@ void StateManager::applyDAWExtraStateToInstance()
 
     audioProcessor->lockHighQuality.store(dawExtraState.lockHQ);
     audioProcessor->lockedHQ = dawExtraState.highQuality;
+
+    audioProcessor->patchCrossfade.store(dawExtraState.patchCrossfade);
+
+    if (dawExtraState.lockSeed)
+    {
+        audioProcessor->setRenderSeed(dawExtraState.seed);
+    }
+    else
+    {
+        audioProcessor->unlockRenderSeed();
+    }
 }
 
 void StateManager::DAWExtraState::fromElement(const juce::XmlElement *e)
@@ -407,45 +780,100 @@ void StateManager::DAWExtraState::fromElement(const juce::XmlElement *e)
     lockPitchBend = e->getBoolAttribute("lockPitchBend", false);
     pitchBendDownRange = e->getIntAttribute("lockedPitchBendDownRange", 2);
     pitchBendUpRange = e->getIntAttribute("lockedPitchBendUpRange", 2);
+
+    patchCrossfade = e->getBoolAttribute("patchCrossfade", false);
+
+    // the XML format predates seed locking
+    lockSeed = false;
+    seed = 0;
 }
 
-std::unique_ptr<juce::XmlElement> StateManager::DAWExtraState::toElement() const
+void StateManager::DAWExtraState::toStream(juce::OutputStream &out) const
 {
-    auto res = std::make_unique<juce::XmlElement>("DAWExtraState");
+    out.writeInt(desVersion);
+
+    for (auto c : controllers)
+    {
+        out.writeInt(c);
+    }
 
-    res->setAttribute("version", desVersion);
+    out.writeByte(static_cast<char>(selectedLFOIndex));
+    out.writeByte(static_cast<char>(selectedMPEDimension));
+    out.writeBool(selectedMPEPanel);
+    out.writeBool(selectedMTSESPPanel);
 
-    for (int idx = 0; idx < 128; ++idx)
+    out.writeFloat(impliedScaleFactor);
+
+    out.writeBool(mpeEnabled);
+    out.writeInt(mpePitchBendRange);
+
+    out.writeInt(static_cast<int>(mutateSections.to_ulong()));
+
+    out.writeBool(lockHQ);
+    out.writeBool(highQuality);
+
+    out.writeBool(dynamicMTSESP);
+
+    out.writeBool(lockPitchBend);
+    out.writeInt(pitchBendDownRange);
+    out.writeInt(pitchBendUpRange);
+
+    out.writeBool(patchCrossfade);
+
+    out.writeBool(lockSeed);
+    out.writeInt(static_cast<int>(seed));
+}
+
+void StateManager::DAWExtraState::fromStream(juce::InputStream &in)
+{
+    // Start from the defaults, so whatever an older stream lacks keeps them
+    *this = DAWExtraState{};
+
+    if (in.getNumBytesRemaining() < 4 + 128 * 4)
     {
-        if (controllers[idx] >= 0)
-        {
-            res->setAttribute("controllers_" + juce::String(idx), controllers[idx]);
-        }
+        return;
     }
 
-    res->setAttribute("selectedLFOIndex", selectedLFOIndex);
-    res->setAttribute("selectedMPEDimension", selectedMPEDimension);
-    res->setAttribute("selectedMPEPanel", selectedMPEPanel);
-    res->setAttribute("selectedMTSESPPanel", selectedMTSESPPanel);
+    const auto sv = in.readInt();
 
-    res->setAttribute("impliedScaleFactor", impliedScaleFactor);
+    if (sv != desVersion)
+    {
+        DBG("Streaming mismatch!");
+    }
 
-    res->setAttribute("mpeEnabled", mpeEnabled);
-    res->setAttribute("mpePitchBendRange", mpePitchBendRange);
+    for (auto &c : controllers)
+    {
+        c = in.readInt();
+    }
+
+    readAppended(in, selectedLFOIndex);
+    readAppended(in, selectedMPEDimension);
+    readAppended(in, selectedMPEPanel);
+    readAppended(in, selectedMTSESPPanel);
+
+    readAppended(in, impliedScaleFactor);
 
-    static_assert(NUM_SECTIONS_TO_MUTATE < 32,
-                  "This synth is not supposed to have this many parameter sections at all!");
+    readAppended(in, mpeEnabled);
+    readAppended(in, mpePitchBendRange);
 
-    res->setAttribute("mutateSections", static_cast<int>(mutateSections.to_ulong()));
+    auto mutateBits = static_cast<int>(mutateSections.to_ulong());
+    readAppended(in, mutateBits);
+    mutateSections = static_cast<unsigned long>(mutateBits);
 
-    res->setAttribute("lockHQ", lockHQ);
-    res->setAttribute("lockedHighQuality", highQuality);
+    readAppended(in, lockHQ);
+    readAppended(in, highQuality);
 
-    res->setAttribute("dynamicMTSESP", dynamicMTSESP);
+    readAppended(in, dynamicMTSESP);
 
-    res->setAttribute("lockPitchBend", lockPitchBend);
-    res->setAttribute("lockedPitchBendDownRange", pitchBendDownRange);
-    res->setAttribute("lockedPitchBendUpRange", pitchBendUpRange);
+    readAppended(in, lockPitchBend);
+    readAppended(in, pitchBendDownRange);
+    readAppended(in, pitchBendUpRange);
 
-    return res;
+    readAppended(in, patchCrossfade);
+
+    if (in.getNumBytesRemaining() >= 1 + 4)
+    {
+        lockSeed = in.readBool();
+        seed = static_cast<uint32_t>(in.readInt());
+    }
 }
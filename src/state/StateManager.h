@@ -24,6 +24,7 @@
 
 #include "Constants.h"
 #include "SynthEngine.h"
+#include "PreparedProgram.h"
 
 class ObxfAudioProcessor;
 
@@ -41,16 +42,29 @@ class StateManager final
     bool loadFromMemoryBlock(juce::MemoryBlock &mb);
     bool loadFromMemoryBlockOntoProgram(juce::MemoryBlock &mb, Program &program);
 
-    bool getChunkFromFxpData(const void *data, size_t dataSize, const void *&outChunkData,
-                             int &outChunkSize);
+    static bool getChunkFromFxpData(const void *data, size_t dataSize, const void *&outChunkData,
+                                    int &outChunkSize);
     void populateProgramFromXml(Program &program, const juce::XmlElement &e,
                                 uint64_t versionNumber);
 
+    // Values of an FXP (or OB-Xd patch) in ParameterList order. Needs no instance, so
+    // the result can be shared between instances; parameter locks are not applied
+    static bool decodeProgramValues(const juce::MemoryBlock &mb, std::vector<float> &out);
+    // As decodeProgramValues, plus the matrix rows and metadata, for the MIDI program bank
+    static bool decodePreparedProgram(const juce::MemoryBlock &mb, PreparedProgram &prepared);
+
+    void applyParameterLocks(Program &program) const;
+
     // This is the API used at the plugin edge. It includes daw extra state and
-    // embeds the program as a subordinate node of the docuemtn
+    // the program, written in the compact binary format. setPluginStateInformation
+    // also reads the XML document older versions wrote, with the program embedded
+    // as a subordinate node of the docuemtn
     void getPluginStateInformation(juce::MemoryBlock &destData) const;
     void setPluginStateInformation(const void *data, int sizeInBytes);
 
+    // Whether the data is plugin state, binary or XML, rather than an FXP or anything else
+    static bool isPluginState(const void *data, int sizeInBytes);
+
     // This is the API used at the FXP. It is just the program on an XML doc.
     void setProgramStateInformation(const void *data, const int sizeInBytes);
     void getProgramStateInformation(juce::MemoryBlock &) const;
@@ -62,17 +76,18 @@ class StateManager final
      * the stream we call collectDAWExtraStateFromInstance before stream.
      * That will let you put whatever you want on the instance here.
      *
-     * Then in the resulting XML we put the result of dawExtraState::toElement
+     * Then at the end of the binary state we write dawExtraState::toStream
      *
-     * On unstream it is the opposite (xml -> fromElement and then after unstream
-     * we do a applyDAWExtraStateToInstance)
+     * On unstream it is the opposite (fromStream, or fromElement for sessions saved
+     * as XML by older versions, and then after unstream we do a applyDAWExtraStateToInstance)
      *
      * that means if you add something to DES you have five steps
      *
      * - add a data member to DAWExtraState
      * - Populate it from the Processor* in collectDAWExtraStateFromInstance
-     * - stream it in toElement
-     * - unstream it in fromElement - but unstream it onto the DAWExtraState object
+     * - append it at the end of toStream
+     * - unstream it at the end of fromStream, guarded by its own bytes remaining check so
+     *   older streams keep the default - but unstream it onto the DAWExtraState object
      * - apply the dawExtraState new member to the Processor in applyDAWExtraStateToInstance
      *
      * Basically the DAWExtraState object acts as a little buffer of
@@ -86,8 +101,12 @@ class StateManager final
     {
         static constexpr int desVersion{1};
 
-        // midi map state
-        std::array<int, 128> controllers{};
+        // midi map state, unbound unless a stream says otherwise
+        std::array<int, 128> controllers = [] {
+            std::array<int, 128> res;
+            res.fill(-1);
+            return res;
+        }();
 
         uint8_t selectedLFOIndex{0};
         uint8_t selectedMPEDimension{0};
@@ -110,12 +129,25 @@ class StateManager final
         bool lockHQ{false};
         bool highQuality{false};
 
-        std::unique_ptr<juce::XmlElement> toElement() const;
+        bool patchCrossfade{false};
+
+        bool lockSeed{false};
+        uint32_t seed{0};
+
         void fromElement(const juce::XmlElement *e);
+
+        void toStream(juce::OutputStream &out) const;
+        void fromStream(juce::InputStream &in);
     } dawExtraState;
 
     ObxfAudioProcessor *audioProcessor{nullptr};
 
+    static float migrateParameterValue(const juce::String &paramId, float value,
+                                       uint64_t versionNumber);
+    // the instance free decoding behind decodeProgramValues and decodePreparedProgram
+    static bool decodeProgram(const juce::MemoryBlock &mb, Program &program, VoiceMatrix *matrix);
+    bool setPluginStateFromBinary(const void *data, int sizeInBytes);
+
     void getActiveProgramStateOnto(juce::XmlElement &) const;
     void setActiveProgramStateFrom(const juce::XmlElement &, uint64_t sVersion);
 };
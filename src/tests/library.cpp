@@ -0,0 +1,79 @@
+/*
+ * OB-Xd was originally written by Vadim Filatov, and then a version
+ * was released under the GPL3 at https://github.com/reales/OB-Xd.
+ * Subsequently, the product was continued by DiscoDSP and the copyright
+ * holders as an excellent closed source product.
+ *
+ * This repository is a successor to OB-Xd version 2.11.
+ * Copyright 2013-2025 by the authors as indicated in the original release,
+ * and subsequent authors as per GitHub transaction log.
+ *
+ * OB-Xf is released under the GNU General Public Licence v3 or later
+ * (GPL-3.0-or-later). The license is found in the file "LICENSE"
+ * in the root of this repository or at:
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * Source code is available at https://github.com/surge-synthesizer/OB-Xf
+ */
+
+/*
+ * Include SynthEngine.h first so the include chain resolves correctly —
+ * same pattern as osc.cpp and filt.cpp.
+ */
+#include "SynthEngine.h"
+#include "PatchLibrary.h"
+
+#include <catch2/catch2.hpp>
+
+TEST_CASE("The patch library only decodes new and changed patches", "[Programs]")
+{
+    const auto dir = juce::File::createTempFile("obxf-library");
+    REQUIRE(dir.createDirectory());
+
+    const auto a = dir.getChildFile("a.fxp");
+    const auto b = dir.getChildFile("b.fxp");
+    REQUIRE(a.replaceWithText("1"));
+    REQUIRE(b.replaceWithText("2"));
+
+    int decodes{0};
+
+    // a patch's single value is its file contents, an empty file fails to decode
+    PatchLibrary library([&decodes](const juce::File &f, PatchLibrary::values_t &out) {
+        ++decodes;
+        const auto text = f.loadFileAsString();
+        out.assign(1, text.getFloatValue());
+        return text.isNotEmpty();
+    });
+
+    REQUIRE(library.get(a) == nullptr);
+
+    library.update({a, b});
+    REQUIRE(decodes == 2);
+    REQUIRE(library.get(a)->front() == 1.f);
+    REQUIRE(library.get(b)->front() == 2.f);
+
+    library.update({a, b});
+    REQUIRE(decodes == 2);
+
+    REQUIRE(b.replaceWithText("33"));
+    library.update({a});
+    REQUIRE(decodes == 2);
+    REQUIRE(library.get(b) == nullptr);
+    REQUIRE(library.numDecoded() == 1);
+
+    library.update({a, b});
+    REQUIRE(decodes == 3);
+    REQUIRE(library.get(b)->front() == 33.f);
+
+    std::atomic<bool> cancel{true};
+    REQUIRE(a.replaceWithText(""));
+    library.update({a, b}, &cancel);
+    REQUIRE(decodes == 3);
+    REQUIRE(library.get(a)->front() == 1.f);
+
+    library.update({a, b});
+    REQUIRE(decodes == 4);
+    REQUIRE(library.get(a) == nullptr);
+
+    dir.deleteRecursively();
+}
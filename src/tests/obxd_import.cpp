@@ -491,3 +491,97 @@ TEST_CASE("ObxdImporter records dropped-parameter warnings", "[obxd]")
     };
     REQUIRE(contains("OCTAVE"));
 }
+
+TEST_CASE("ObxdImporter imports banks in parallel like a serial import", "[obxd]")
+{
+    auto makeBank = [](const juce::String &prefix) {
+        juce::XmlElement root{"discoDSP"};
+        auto *programsNode = new juce::XmlElement("programs");
+
+        for (int i = 0; i < OBXD_BANK_SIZE; ++i)
+        {
+            // a few init patches, and two programs sharing a name of which the later must win
+            const auto name = (i % 10 == 9) ? juce::String("Default")
+                              : (i == 3 || i == 100) ? juce::String("Dup")
+                                                     : prefix + juce::String(i);
+
+            auto *progEl = new juce::XmlElement(makeDiscoDSPElement(name));
+            progEl->setTagName("program");
+            progEl->setAttribute("Val_" + juce::String(VOLUME), i / 128.0);
+            programsNode->addChildElement(progEl);
+        }
+
+        root.addChildElement(programsNode);
+
+        return wrapAsFBCh(root);
+    };
+
+    const struct ScratchDir
+    {
+        juce::File dir{juce::File::createTempFile("obxd-import")};
+        ~ScratchDir() { dir.deleteRecursively(); }
+    } scratch;
+
+    const auto srcDir = scratch.dir.getChildFile("src");
+    const auto destDir = scratch.dir.getChildFile("dest");
+    REQUIRE(srcDir.createDirectory());
+
+    std::vector<juce::File> banks{srcDir.getChildFile("A.fxb"), srcDir.getChildFile("B.fxb"),
+                                  srcDir.getChildFile("Broken.fxb")};
+
+    REQUIRE(banks[0].replaceWithData(makeBank("A").getData(), makeBank("A").getSize()));
+    REQUIRE(banks[1].replaceWithData(makeBank("B").getData(), makeBank("B").getSize()));
+    REQUIRE(banks[2].replaceWithText("not a bank"));
+
+    // stand-in serializer writing the volume, so we can tell which program a file came from
+    auto serialize = [](const Program &prog, juce::MemoryBlock &mb) {
+        const auto text = juce::String(prog.getValueById(ID::Volume));
+        mb.append(text.toRawUTF8(), text.getNumBytesAsUTF8());
+        return true;
+    };
+
+    SECTION("all programs are written")
+    {
+        ObxdImporter::BankImportOptions options;
+        options.numWorkers = 4;
+        options.writeBatchSize = 5;
+
+        int progressCalls = 0;
+        options.progress = [&](const ObxdImporter::BankImportProgress &p) {
+            ++progressCalls;
+            REQUIRE(p.banksTotal == 3);
+        };
+
+        const auto result = ObxdImporter::importBanks(banks, destDir, serialize, options);
+        const int initPerBank = OBXD_BANK_SIZE / 10;
+
+        REQUIRE(result.failedBanks == 1);
+        REQUIRE(result.skipped == 2 * initPerBank);
+        REQUIRE(result.imported == 2 * (OBXD_BANK_SIZE - initPerBank));
+        REQUIRE_FALSE(result.cancelled);
+        REQUIRE(progressCalls > 0);
+
+        for (const auto *bank : {"A", "B"})
+        {
+            const auto folder = destDir.getChildFile(bank);
+
+            REQUIRE(folder.findChildFiles(juce::File::findFiles, false, "*.fxp").size() ==
+                    OBXD_BANK_SIZE - initPerBank - 1);
+            REQUIRE(folder.getChildFile("Dup.fxp").loadFileAsString().getFloatValue() ==
+                    Approx(100.0 / 128.0));
+        }
+    }
+
+    SECTION("cancelling stops early")
+    {
+        ObxdImporter::BankImportOptions options;
+        options.numWorkers = 2;
+        options.writeBatchSize = 1;
+        options.shouldCancel = []() { return true; };
+
+        const auto result = ObxdImporter::importBanks(banks, destDir, serialize, options);
+
+        REQUIRE(result.cancelled);
+        REQUIRE(result.imported < 2 * OBXD_BANK_SIZE);
+    }
+}
@@ -0,0 +1,145 @@
+/*
+ * OB-Xd was originally written by Vadim Filatov, and then a version
+ * was released under the GPL3 at https://github.com/reales/OB-Xd.
+ * Subsequently, the product was continued by DiscoDSP and the copyright
+ * holders as an excellent closed source product.
+ *
+ * This repository is a successor to OB-Xd version 2.11.
+ * Copyright 2013-2025 by the authors as indicated in the original release,
+ * and subsequent authors as per GitHub transaction log.
+ *
+ * OB-Xf is released under the GNU General Public Licence v3 or later
+ * (GPL-3.0-or-later). The license is found in the file "LICENSE"
+ * in the root of this repository or at:
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * Source code is available at https://github.com/surge-synthesizer/OB-Xf
+ */
+
+#include "ObxfProcessor.h"
+#include "ParameterList.h"
+#include "RenderPool.h"
+#include "RenderCache.h"
+
+#include <catch2/catch2.hpp>
+
+#include <limits>
+#include <vector>
+
+static RenderPool::Job makeJob(std::vector<float> parameters, int note, int numSamples,
+                               std::vector<float> &out)
+{
+    RenderPool::Job job;
+    job.parameters = std::move(parameters);
+    job.events = {{0, RenderEvent::NoteOn, 0, static_cast<uint16_t>(note), 100.f},
+                  {numSamples / 2, RenderEvent::NoteOff, 0, static_cast<uint16_t>(note), 0.f}};
+    job.numSamples = numSamples;
+
+    out.assign(2 * static_cast<size_t>(numSamples), 0.f);
+    job.left = out.data();
+    job.right = out.data() + numSamples;
+
+    return job;
+}
+
+TEST_CASE("A pool job renders the same after another job", "[RenderPool]")
+{
+    juce::ScopedJuceInitialiser_GUI juce;
+
+    constexpr int numSamples{24000};
+    const auto nan = std::numeric_limits<float>::quiet_NaN();
+
+    // an audible LFO, so a phase carried over from the job before would show
+    std::vector<float> a(ParameterList.size(), nan);
+    a[parameterListIndexOf(SynthParam::ID::LFO1Rate)] = 0.6f;
+    a[parameterListIndexOf(SynthParam::ID::LFO1ModAmount1)] = 0.5f;
+    a[parameterListIndexOf(SynthParam::ID::LFO1ToOsc1Pitch)] = 1.f;
+
+    // a different cutoff and resonance for the smoothers to glide back from
+    std::vector<float> b(ParameterList.size(), nan);
+    b[parameterListIndexOf(SynthParam::ID::FilterCutoff)] = 0.1f;
+    b[parameterListIndexOf(SynthParam::ID::FilterResonance)] = 0.9f;
+
+    std::vector<float> first, second, third;
+    std::vector<RenderPool::Job> jobs{makeJob(a, 60, numSamples, first),
+                                      makeJob(b, 43, numSamples, second),
+                                      makeJob(a, 60, numSamples, third)};
+
+    // one worker, so all three jobs run on the same engine, in order
+    RenderPool pool(1, 48000.0);
+    pool.render(jobs);
+
+    for (const auto &job : jobs)
+    {
+        REQUIRE(job.error.empty());
+    }
+
+    REQUIRE(first == third);
+    REQUIRE(first != second);
+}
+
+TEST_CASE("The render cache stores, fetches and evicts renders", "[RenderCache]")
+{
+    juce::ScopedJuceInitialiser_GUI juce;
+
+    constexpr int numSamples{256};
+    const auto folder = juce::File::createTempFile("obxf-render-cache");
+
+    ObxfAudioProcessor processor;
+    const std::vector<RenderEvent> events{{0, RenderEvent::NoteOn, 0, 60, 100.f}};
+
+    std::vector<float> left(numSamples), right(numSamples);
+    for (int i = 0; i < numSamples; ++i)
+    {
+        left[static_cast<size_t>(i)] = static_cast<float>(i);
+        right[static_cast<size_t>(i)] = -static_cast<float>(i);
+    }
+
+    const auto key = RenderCache::keyFor(processor, events, numSamples, 48000.0);
+    std::vector<float> l(numSamples), r(numSamples);
+
+    {
+        RenderCache cache(folder.getChildFile("store"), int64_t{1} << 20);
+        REQUIRE(!cache.fetch(key, numSamples, l.data(), r.data()));
+
+        cache.store(key, numSamples, left.data(), right.data());
+        REQUIRE(cache.fetch(key, numSamples, l.data(), r.data()));
+        REQUIRE(l == left);
+        REQUIRE(r == right);
+
+        // same file name, but the digest in its header doesn't match
+        auto collided = key;
+        collided.digest ^= 1;
+        REQUIRE(!cache.fetch(collided, numSamples, l.data(), r.data()));
+        REQUIRE(!cache.fetch(key, numSamples / 2, l.data(), r.data()));
+    }
+
+    // a controller bound to another parameter renders differently
+    const auto cutoff = parameterListIndexOf(SynthParam::ID::FilterCutoff);
+    processor.getMidiMap().updateCC(static_cast<int>(ParameterList[cutoff].meta.id), 20);
+    const auto bound = RenderCache::keyFor(processor, events, numSamples, 48000.0);
+    REQUIRE(bound.name != key.name);
+    REQUIRE(bound.digest != key.digest);
+
+    {
+        // room for a single render, so storing a second evicts the first
+        int64_t oneRender{0};
+        {
+            RenderCache probe(folder.getChildFile("probe"), int64_t{1} << 20);
+            probe.store(key, numSamples, left.data(), right.data());
+            oneRender = probe.getSizeInBytes();
+        }
+
+        RenderCache cache(folder.getChildFile("evict"), oneRender);
+        cache.store(key, numSamples, left.data(), right.data());
+        juce::Thread::sleep(5); // so the first is the older by the clock
+        cache.store(bound, numSamples, right.data(), left.data());
+
+        REQUIRE(cache.getSizeInBytes() <= oneRender);
+        REQUIRE(!cache.fetch(key, numSamples, l.data(), r.data()));
+        REQUIRE(cache.fetch(bound, numSamples, l.data(), r.data()));
+        REQUIRE(l == right);
+    }
+
+    folder.deleteRecursively();
+}
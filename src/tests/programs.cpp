@@ -0,0 +1,77 @@
+/*
+ * OB-Xd was originally written by Vadim Filatov, and then a version
+ * was released under the GPL3 at https://github.com/reales/OB-Xd.
+ * Subsequently, the product was continued by DiscoDSP and the copyright
+ * holders as an excellent closed source product.
+ *
+ * This repository is a successor to OB-Xd version 2.11.
+ * Copyright 2013-2025 by the authors as indicated in the original release,
+ * and subsequent authors as per GitHub transaction log.
+ *
+ * OB-Xf is released under the GNU General Public Licence v3 or later
+ * (GPL-3.0-or-later). The license is found in the file "LICENSE"
+ * in the root of this repository or at:
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * Source code is available at https://github.com/surge-synthesizer/OB-Xf
+ */
+
+/*
+ * Include SynthEngine.h first so the include chain resolves correctly —
+ * same pattern as osc.cpp and filt.cpp.
+ */
+#include "SynthEngine.h"
+#include "PreparedProgram.h"
+
+#include <catch2/catch2.hpp>
+
+/* A bank of n programs whose patch indices start at first. */
+static PreparedProgramBank::programs_t makePrograms(int first, int n)
+{
+    PreparedProgramBank::programs_t programs(static_cast<size_t>(n));
+
+    for (int i = 0; i < n; ++i)
+        programs[static_cast<size_t>(i)].patchIndex = first + i;
+
+    return programs;
+}
+
+TEST_CASE("An applied program outlives rescans until it is taken", "[Programs]")
+{
+    PreparedProgramBank bank;
+    bank.publish(makePrograms(100, 4));
+
+    const auto *applied = bank.get(2);
+    REQUIRE(applied);
+    bank.markApplied(applied);
+
+    // more rescans than the bank retains generations for
+    for (int i = 0; i < 8; ++i)
+        bank.publish(makePrograms(200 + 10 * i, 4));
+
+    const auto *taken = bank.takeApplied();
+    REQUIRE(taken == applied);
+    REQUIRE(taken->patchIndex == 102);
+
+    REQUIRE(bank.takeApplied() == nullptr);
+    REQUIRE(bank.get(2)->patchIndex == 272);
+}
+
+TEST_CASE("Banks publishing the same programs share them", "[Programs]")
+{
+    const auto shared = std::make_shared<const PreparedProgramBank::programs_t>(makePrograms(7, 3));
+
+    PreparedProgramBank first, second;
+    first.publish(shared);
+    second.publish(shared);
+
+    REQUIRE(first.get(1) == second.get(1));
+    REQUIRE(first.get(1)->patchIndex == 8);
+
+    // republishing what is already current is not a new generation
+    first.publish(shared);
+    REQUIRE(first.size() == 3);
+
+    first.publish(nullptr);
+    REQUIRE(first.get(0) == second.get(0));
+}
@@ -0,0 +1,234 @@
+/*
+ * OB-Xd was originally written by Vadim Filatov, and then a version
+ * was released under the GPL3 at https://github.com/reales/OB-Xd.
+ * Subsequently, the product was continued by DiscoDSP and the copyright
+ * holders as an excellent closed source product.
+ *
+ * This repository is a successor to OB-Xd version 2.11.
+ * Copyright 2013-2025 by the authors as indicated in the original release,
+ * and subsequent authors as per GitHub transaction log.
+ *
+ * OB-Xf is released under the GNU General Public Licence v3 or later
+ * (GPL-3.0-or-later). The license is found in the file "LICENSE"
+ * in the root of this repository or at:
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * Source code is available at https://github.com/surge-synthesizer/OB-Xf
+ */
+
+/*
+ * Include SynthEngine.h first so the include chain resolves correctly —
+ * same pattern as osc.cpp and filt.cpp.
+ */
+#include "SynthEngine.h"
+#include "RealtimeScope.h"
+#include "ObxfProcessor.h"
+#include "ParameterList.h"
+
+#include <catch2/catch2.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <thread>
+
+/*
+ * Replacing the global allocation functions lets us catch heap traffic from inside
+ * an obxf::realtime::Scope in every build. An ENABLE_RTSAN build additionally traps
+ * locks and blocking syscalls, and aborts the test run on the first one.
+ */
+void *operator new(std::size_t size)
+{
+    if (obxf::realtime::inScope())
+        obxf::realtime::reportViolation("operator new");
+
+    if (auto *p = std::malloc(size ? size : 1))
+        return p;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept
+{
+    if (p && obxf::realtime::inScope())
+        obxf::realtime::reportViolation("operator delete");
+
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept { operator delete(p); }
+
+/* Render n samples the way processBlock does, discarding the output. */
+static void render(SynthEngine &eng, int n)
+{
+    float l{0.f}, r{0.f};
+    for (int i = 0; i < n; ++i)
+        eng.processSample(&l, &r);
+}
+
+/* Add a short MIDI message to a buffer which was sized up front, so nothing allocates. */
+static void addMidi(juce::MidiBuffer &midi, int pos, uint8_t status, uint8_t d1, uint8_t d2 = 0)
+{
+    const uint8_t msg[3]{status, d1, d2};
+    midi.addEvent(msg, juce::MidiMessage::getMessageLengthFromFirstByte(status), pos);
+}
+
+TEST_CASE("Realtime scope reports allocations", "[realtime]")
+{
+    const auto before = obxf::realtime::violations().load();
+
+    {
+        obxf::realtime::Scope rt;
+        auto *leak = new int(3);
+        delete leak;
+    }
+
+    REQUIRE(obxf::realtime::violations().load() == before + 2);
+}
+
+TEST_CASE("Scripted engine session is realtime safe", "[realtime]")
+{
+    constexpr int blockSize{64};
+
+    SynthEngine eng, shadow;
+    eng.setSampleRate(48000.f);
+    shadow.setSampleRate(48000.f);
+    eng.getMotherboard()->setPolyphony(8);
+    eng.getMotherboard()->voiceMatrix.setModulation("Strike", SynthParam::ID::FilterCutoff, 0.5f,
+                                                    0);
+
+    const auto before = obxf::realtime::violations().load();
+
+    {
+        obxf::realtime::Scope rt;
+
+        eng.processVolume(0.5f);
+        eng.processAmpEnvRelease(0.3f);
+        eng.processFilterCutoff(0.6f);
+
+        // chords, bends and sustain
+        for (int note = 48; note < 60; note += 4)
+            eng.processNoteOn(note, 0.8f, 1);
+        render(eng, blockSize * 4);
+
+        eng.processPitchWheel(0.7f);
+        eng.processModWheel(0.4f);
+        eng.sustainOn();
+        render(eng, blockSize);
+
+        for (int note = 48; note < 60; note += 4)
+            eng.processNoteOff(note, 0.f, 1);
+        render(eng, blockSize);
+
+        // voice stealing past the polyphony limit
+        for (int note = 60; note < 72; ++note)
+            eng.processNoteOn(note, 0.6f, 1);
+        render(eng, blockSize * 2);
+
+        // HQ toggle and a patch crossfade hand-off into the shadow engine
+        eng.processHQMode(1.f);
+        shadow.cloneFrom(eng);
+        eng.allSoundOff();
+        eng.processNoteOn(64, 1.f, 1);
+        render(eng, blockSize);
+        render(shadow, blockSize);
+
+        eng.sustainOff();
+        eng.allNotesOff();
+        render(eng, blockSize * 4);
+
+        eng.processIdle(blockSize * 8);
+    }
+
+    REQUIRE(obxf::realtime::violations().load() == before);
+}
+
+TEST_CASE("Scripted processor session is realtime safe", "[realtime]")
+{
+    juce::ScopedJuceInitialiser_GUI juce;
+
+    constexpr int blockSize{64};
+    constexpr int numBlocks{600};
+    constexpr uint8_t sweptCC{20};
+
+    ObxfAudioProcessor proc;
+    proc.patchCrossfade = true;
+
+    // two programs to switch between, so program changes also start crossfades
+    PreparedProgramBank::programs_t programs(2);
+    for (auto &p : programs)
+        p.setFrom(Program(), VoiceMatrix());
+    programs[1].values[parameterListIndexOf(SynthParam::ID::FilterCutoff)] = 0.2f;
+    proc.getMidiProgramBank().publish(std::move(programs));
+
+    // a bound controller, so the sweeps go through the MIDI lags
+    const auto resonance = parameterListIndexOf(SynthParam::ID::FilterResonance);
+    proc.getMidiMap().updateCC(static_cast<int>(ParameterList[resonance].meta.id), sweptCC);
+
+    proc.prepareToPlay(48000.0, blockSize);
+
+    juce::AudioBuffer<float> buffer(2, blockSize);
+    juce::MidiBuffer midi;
+    midi.ensureSize(4096);
+
+    // the host automating parameters from its own thread while we play, and an editor
+    // coming and going with its parameter callbacks
+    std::atomic<bool> automating{true};
+    std::thread automation([&proc, &automating]() {
+        auto &coordinator = proc.getParamCoordinator();
+        auto &updateHandler = coordinator.getParameterUpdateHandler();
+        auto *cutoff = coordinator.getParameter(SynthParam::ID::FilterCutoff);
+        auto *lfoRate = coordinator.getParameter(SynthParam::ID::LFO1Rate);
+        float v{0.f};
+
+        while (automating)
+        {
+            v = (v >= 1.f) ? 0.f : v + 0.01f;
+            cutoff->setValueNotifyingHost(v);
+            lfoRate->setValueNotifyingHost(1.f - v);
+
+            updateHandler.addParameterCallback(SynthParam::ID::FilterCutoff, "editor",
+                                               [](float, bool) {});
+            updateHandler.removeParameterCallback(SynthParam::ID::FilterCutoff, "editor");
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    });
+
+    const auto before = obxf::realtime::violations().load();
+
+    for (int block = 0; block < numBlocks; ++block)
+    {
+        const auto sweep = static_cast<uint8_t>((block * 3) % 128);
+        midi.clear();
+
+        // chords which are held for half of every 50 blocks
+        if (block % 50 == 0)
+            for (uint8_t note = 48; note < 60; note += 4)
+                addMidi(midi, 0, 0x90, note, 100);
+        if (block % 50 == 25)
+            for (uint8_t note = 48; note < 60; note += 4)
+                addMidi(midi, 8, 0x80, note, 0);
+
+        // controller sweeps, bends and the sustain pedal
+        addMidi(midi, 0, 0xB0, sweptCC, sweep);
+        addMidi(midi, 16, 0xB0, 1, sweep);
+        addMidi(midi, 24, 0xB0, 74, static_cast<uint8_t>(127 - sweep));
+        addMidi(midi, 32, 0xE0, 0, sweep);
+        if (block % 150 == 5)
+            addMidi(midi, 40, 0xB0, 64, 127);
+        if (block % 150 == 80)
+            addMidi(midi, 40, 0xB0, 64, 0);
+
+        // program changes while the chords are held
+        if (block % 100 == 10)
+            addMidi(midi, 48, 0xC0, static_cast<uint8_t>((block / 100) % 2));
+
+        proc.processBlock(buffer, midi);
+    }
+
+    automating = false;
+    automation.join();
+
+    REQUIRE(obxf::realtime::violations().load() == before);
+}
@@ -0,0 +1,125 @@
+/*
+ * OB-Xd was originally written by Vadim Filatov, and then a version
+ * was released under the GPL3 at https://github.com/reales/OB-Xd.
+ * Subsequently, the product was continued by DiscoDSP and the copyright
+ * holders as an excellent closed source product.
+ *
+ * This repository is a successor to OB-Xd version 2.11.
+ * Copyright 2013-2025 by the authors as indicated in the original release,
+ * and subsequent authors as per GitHub transaction log.
+ *
+ * OB-Xf is released under the GNU General Public Licence v3 or later
+ * (GPL-3.0-or-later). The license is found in the file "LICENSE"
+ * in the root of this repository or at:
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * Source code is available at https://github.com/surge-synthesizer/OB-Xf
+ */
+
+#include "ObxfProcessor.h"
+#include "OfflineRenderer.h"
+
+#include <catch2/catch2.hpp>
+
+#include <vector>
+
+static void addRPN(std::vector<RenderEvent> &events, uint8_t channel, uint16_t lsb, float value)
+{
+    events.push_back({0, RenderEvent::Controller, channel, 101, 0.f});
+    events.push_back({0, RenderEvent::Controller, channel, 100, static_cast<float>(lsb)});
+    events.push_back({0, RenderEvent::Controller, channel, 6, value});
+}
+
+TEST_CASE("Offline renders apply RPNs without a message loop", "[OfflineRenderer]")
+{
+    juce::ScopedJuceInitialiser_GUI juce;
+
+    ObxfAudioProcessor processor;
+    OfflineRenderer renderer(processor);
+    renderer.prepare(48000.0);
+
+    auto &midiHandler = processor.getMidiHandler();
+    REQUIRE(!midiHandler.mpeEnabled.load());
+
+    std::vector<RenderEvent> events;
+
+    // MPE configuration with 15 member channels, then a member channel bend range of 24
+    addRPN(events, 0, 6, 15.f);
+    addRPN(events, 1, 0, 24.f);
+
+    std::vector<float> left(1024), right(1024);
+    renderer.render(events, 1024, left.data(), right.data());
+
+    REQUIRE(midiHandler.mpeEnabled.load());
+    REQUIRE(midiHandler.mpePitchBendRange.load() == 24);
+}
+
+TEST_CASE("Program changes come through as events", "[OfflineRenderer]")
+{
+    RenderEvent e;
+
+    REQUIRE(OfflineRenderer::eventFromMidi(juce::MidiMessage::programChange(3, 17), 100, e));
+    REQUIRE(e.type == RenderEvent::ProgramChange);
+    REQUIRE(e.number == 17);
+    REQUIRE(e.channel == 2);
+    REQUIRE(e.time == 100);
+}
+
+TEST_CASE("An automation lane wins over a parameter event at the same sample",
+          "[OfflineRenderer]")
+{
+    juce::ScopedJuceInitialiser_GUI juce;
+
+    ObxfAudioProcessor processor;
+    OfflineRenderer renderer(processor);
+    renderer.prepare(48000.0);
+
+    size_t cutoff{0};
+
+    while (ParameterList[cutoff].ID.toStdString() != SynthParam::ID::FilterCutoff)
+        ++cutoff;
+
+    // a flat curve, so only the event could ever move the parameter away from it
+    const float points[1] = {0.25f};
+    const std::vector<AutomationLane> lanes{{static_cast<uint16_t>(cutoff), points, 1, 1.0}};
+
+    std::vector<RenderEvent> events{
+        {1000, RenderEvent::Parameter, 0, static_cast<uint16_t>(cutoff), 0.9f}};
+
+    std::vector<float> left(2048), right(2048);
+    renderer.render(events, lanes, 2048, left.data(), right.data());
+
+    REQUIRE(processor.getActiveProgram().valueAt(cutoff).load() == 0.25f);
+}
+
+TEST_CASE("Offline renders take what the audio thread handed over", "[OfflineRenderer]")
+{
+    juce::ScopedJuceInitialiser_GUI juce;
+
+    ObxfAudioProcessor processor;
+    OfflineRenderer renderer(processor);
+    renderer.prepare(48000.0);
+
+    const auto cutoff = parameterListIndexOf(SynthParam::ID::FilterCutoff);
+    const auto resonance = parameterListIndexOf(SynthParam::ID::FilterResonance);
+
+    PreparedProgramBank::programs_t programs(2);
+    for (auto &p : programs)
+        p.setFrom(Program(), VoiceMatrix());
+    programs[1].values[cutoff] = 0.2f;
+    processor.getMidiProgramBank().publish(std::move(programs));
+
+    // a bound controller, so its value comes to rest through a MIDI lag
+    processor.getMidiMap().updateCC(static_cast<int>(ParameterList[resonance].meta.id), 20);
+
+    std::vector<RenderEvent> events{{100, RenderEvent::ProgramChange, 0, 1, 0.f},
+                                    {200, RenderEvent::Controller, 0, 20, 127.f}};
+
+    std::vector<float> left(48000), right(48000);
+    renderer.render(events, 48000, left.data(), right.data());
+
+    auto &program = processor.getActiveProgram();
+    REQUIRE(program.valueAt(static_cast<size_t>(cutoff)).load() == Approx(0.2f));
+    REQUIRE(program.valueAt(static_cast<size_t>(resonance)).load() == Approx(1.f));
+    REQUIRE(processor.getMidiProgramBank().takeApplied() == nullptr);
+}
@@ -0,0 +1,88 @@
+/*
+ * OB-Xd was originally written by Vadim Filatov, and then a version
+ * was released under the GPL3 at https://github.com/reales/OB-Xd.
+ * Subsequently, the product was continued by DiscoDSP and the copyright
+ * holders as an excellent closed source product.
+ *
+ * This repository is a successor to OB-Xd version 2.11.
+ * Copyright 2013-2025 by the authors as indicated in the original release,
+ * and subsequent authors as per GitHub transaction log.
+ *
+ * OB-Xf is released under the GNU General Public Licence v3 or later
+ * (GPL-3.0-or-later). The license is found in the file "LICENSE"
+ * in the root of this repository or at:
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * Source code is available at https://github.com/surge-synthesizer/OB-Xf
+ */
+
+
+/*
+ * Include SynthEngine.h first so the include chain resolves correctly —
+ * same pattern as osc.cpp and filt.cpp.
+ */
+#include "SynthEngine.h"
+#include "ObxfProcessor.h"
+
+#include <catch2/catch2.hpp>
+
+#include <vector>
+
+/* Play a chord through noise and slop and return the left channel. */
+static std::vector<float> renderSeeded(uint32_t seed)
+{
+    SynthEngine eng;
+    eng.setSeed(seed);
+    eng.setSampleRate(48000.f);
+    eng.getMotherboard()->setPolyphony(8);
+
+    eng.processVolume(0.5f);
+    eng.processNoiseVolume(0.5f);
+    eng.processFilterSlop(1.f);
+    eng.processLevelSlop(1.f);
+
+    for (int note = 48; note < 60; note += 4)
+        eng.processNoteOn(note, 0.8f, 1);
+
+    std::vector<float> out(4096);
+    float r{0.f};
+
+    for (auto &l : out)
+        eng.processSample(&l, &r);
+
+    return out;
+}
+
+TEST_CASE("Same seed renders bit identical output", "[Seed]")
+{
+    const auto a = renderSeeded(1234);
+    const auto b = renderSeeded(1234);
+
+    REQUIRE(a == b);
+}
+
+TEST_CASE("Different seeds render different output", "[Seed]")
+{
+    const auto a = renderSeeded(1234);
+    const auto b = renderSeeded(5678);
+
+    REQUIRE(a != b);
+}
+
+TEST_CASE("Restoring a session without a locked seed unlocks it", "[Seed]")
+{
+    juce::ScopedJuceInitialiser_GUI juce;
+
+    ObxfAudioProcessor unlocked;
+    juce::MemoryBlock state;
+    unlocked.getStateInformation(state);
+
+    ObxfAudioProcessor processor;
+    processor.setRenderSeed(1234);
+    REQUIRE(processor.lockSeed.load());
+
+    processor.setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+
+    REQUIRE(!processor.lockSeed.load());
+    REQUIRE(processor.getRenderSeed() != 1234);
+}
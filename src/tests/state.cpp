@@ -0,0 +1,195 @@
+/*
+ * OB-Xd was originally written by Vadim Filatov, and then a version
+ * was released under the GPL3 at https://github.com/reales/OB-Xd.
+ * Subsequently, the product was continued by DiscoDSP and the copyright
+ * holders as an excellent closed source product.
+ *
+ * This repository is a successor to OB-Xd version 2.11.
+ * Copyright 2013-2025 by the authors as indicated in the original release,
+ * and subsequent authors as per GitHub transaction log.
+ *
+ * OB-Xf is released under the GNU General Public Licence v3 or later
+ * (GPL-3.0-or-later). The license is found in the file "LICENSE"
+ * in the root of this repository or at:
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * Source code is available at https://github.com/surge-synthesizer/OB-Xf
+ */
+
+#include "ObxfProcessor.h"
+
+#include <catch2/catch2.hpp>
+
+#include <vector>
+
+static size_t indexOf(const std::string &paramId)
+{
+    const auto idx = parameterListIndexOf(paramId);
+    REQUIRE(idx >= 0);
+    return static_cast<size_t>(idx);
+}
+
+static juce::MemoryBlock stateOf(ObxfAudioProcessor &processor)
+{
+    juce::MemoryBlock mb;
+    processor.getStateInformation(mb);
+    return mb;
+}
+
+static void restore(ObxfAudioProcessor &processor, const juce::MemoryBlock &mb)
+{
+    processor.setStateInformation(mb.getData(), static_cast<int>(mb.getSize()));
+}
+
+static float defaultOf(size_t index)
+{
+    const auto &meta = ParameterList[index].meta;
+    return meta.naturalToNormalized01(meta.defaultVal);
+}
+
+/* The ID hash the binary format keys parameters by, FNV-1a over the UTF-8 ID. */
+static uint32_t hashOf(const juce::String &id)
+{
+    uint32_t h{2166136261u};
+
+    for (auto *c = id.toRawUTF8(); *c; ++c)
+        h = (h ^ static_cast<uint8_t>(*c)) * 16777619u;
+
+    return h;
+}
+
+TEST_CASE("Binary state round trips the program and the DAW extra state", "[State]")
+{
+    juce::ScopedJuceInitialiser_GUI juce;
+
+    const auto cutoff = indexOf(SynthParam::ID::FilterCutoff);
+    const auto resonance = indexOf(SynthParam::ID::FilterResonance);
+
+    ObxfAudioProcessor source;
+    auto &program = source.getActiveProgram();
+    program.setValueById(ParameterList[cutoff].ID, 0.25f);
+    program.setValueById(ParameterList[resonance].ID, 0.75f);
+    program.setName("Round Trip");
+    program.setAuthor("Tests");
+    source.patchCrossfade.store(true);
+    source.setRenderSeed(4321);
+
+    const auto mb = stateOf(source);
+    REQUIRE(StateManager::isPluginState(mb.getData(), static_cast<int>(mb.getSize())));
+
+    ObxfAudioProcessor dest;
+    restore(dest, mb);
+
+    const auto &restored = dest.getActiveProgram();
+
+    for (const auto &param : ParameterList)
+        REQUIRE(restored.getValueById(param.ID) == program.getValueById(param.ID));
+
+    REQUIRE(restored.getName() == "Round Trip");
+    REQUIRE(restored.getAuthor() == "Tests");
+    REQUIRE(dest.patchCrossfade.load());
+    REQUIRE(dest.lockSeed.load());
+    REQUIRE(dest.getRenderSeed() == 4321);
+}
+
+TEST_CASE("Binary state with another parameter layout loads by ID hash", "[State]")
+{
+    juce::ScopedJuceInitialiser_GUI juce;
+
+    const auto cutoff = indexOf(SynthParam::ID::FilterCutoff);
+    const auto resonance = indexOf(SynthParam::ID::FilterResonance);
+
+    // two known parameters in the opposite order and one this build doesn't have
+    juce::MemoryBlock mb;
+    {
+        juce::MemoryOutputStream out(mb, false);
+        out.write("OBXB", 4);
+        out.writeInt(1);
+        out.writeInt64(static_cast<juce::int64>(currentStreamingVersion));
+        out.writeInt(0);
+        out.writeInt(3);
+
+        out.writeFloat(0.6f);
+        out.writeFloat(0.5f);
+        out.writeFloat(0.9f);
+
+        out.writeInt(static_cast<int>(hashOf(ParameterList[resonance].ID)));
+        out.writeInt(static_cast<int>(hashOf("NOT_A_PARAMETER")));
+        out.writeInt(static_cast<int>(hashOf(ParameterList[cutoff].ID)));
+
+        for (int i = 0; i < 5; ++i)
+            out.writeString("");
+
+        out.writeInt(0);
+    }
+
+    ObxfAudioProcessor processor;
+    restore(processor, mb);
+
+    const auto &program = processor.getActiveProgram();
+    REQUIRE(program.getValueById(ParameterList[resonance].ID) == Approx(0.6f));
+    REQUIRE(program.getValueById(ParameterList[cutoff].ID) == Approx(0.9f));
+
+    for (size_t i = 0; i < ParameterList.size(); ++i)
+        if (i != cutoff && i != resonance)
+            REQUIRE(program.getValueById(ParameterList[i].ID) == Approx(defaultOf(i)));
+}
+
+TEST_CASE("A truncated DAW extra state keeps the defaults for what is missing", "[State]")
+{
+    juce::ScopedJuceInitialiser_GUI juce;
+
+    ObxfAudioProcessor source;
+    source.patchCrossfade.store(true);
+    source.setRenderSeed(4321);
+
+    // drop the seed lock and the seed, which are the last members written
+    auto mb = stateOf(source);
+    mb.setSize(mb.getSize() - 5);
+
+    ObxfAudioProcessor dest;
+    dest.setRenderSeed(1234);
+    restore(dest, mb);
+
+    REQUIRE(dest.patchCrossfade.load());
+    REQUIRE(!dest.lockSeed.load());
+    REQUIRE(dest.getRenderSeed() != 1234);
+}
+
+TEST_CASE("Sessions saved as XML still load", "[State]")
+{
+    juce::ScopedJuceInitialiser_GUI juce;
+
+    const auto cutoff = indexOf(SynthParam::ID::FilterCutoff);
+    const auto resonance = indexOf(SynthParam::ID::FilterResonance);
+
+    juce::XmlElement xml("OB-Xf");
+    xml.setAttribute("ob-xf_version", humanReadableVersion(currentStreamingVersion));
+
+    auto *program = xml.createNewChildElement("program");
+    program->setAttribute(ParameterList[cutoff].ID, 0.3);
+    program->setAttribute("voiceCount", MAX_VOICES);
+    program->setAttribute("programName", "Legacy");
+
+    auto *extra = xml.createNewChildElement("dawExtraState")->createNewChildElement("state");
+    extra->setAttribute("version", 1);
+    extra->setAttribute("mpePitchBendRange", 24);
+    extra->setAttribute("patchCrossfade", true);
+
+    juce::MemoryBlock mb;
+    juce::AudioProcessor::copyXmlToBinary(xml, mb);
+    REQUIRE(StateManager::isPluginState(mb.getData(), static_cast<int>(mb.getSize())));
+
+    ObxfAudioProcessor processor;
+    processor.setRenderSeed(1234);
+    restore(processor, mb);
+
+    const auto &restored = processor.getActiveProgram();
+    REQUIRE(restored.getName() == "Legacy");
+    REQUIRE(restored.getValueById(ParameterList[cutoff].ID) == Approx(0.3f));
+    REQUIRE(restored.getValueById(ParameterList[resonance].ID) == Approx(defaultOf(resonance)));
+
+    REQUIRE(processor.getMidiHandler().mpePitchBendRange.load() == 24);
+    REQUIRE(processor.patchCrossfade.load());
+    REQUIRE(!processor.lockSeed.load());
+}
@@ -50,6 +50,8 @@ struct MenuAction
 
     static constexpr int ImportObxdBank = 13;
 
+    static constexpr int SearchPatches = 14;
+
     static constexpr int Inspector = 100;
 };
 
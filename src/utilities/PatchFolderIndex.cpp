@@ -0,0 +1,195 @@
+/*
+ * OB-Xd was originally written by Vadim Filatov, and then a version
+ * was released under the GPL3 at https://github.com/reales/OB-Xd.
+ * Subsequently, the product was continued by DiscoDSP and the copyright
+ * holders as an excellent closed source product.
+ *
+ * This repository is a successor to OB-Xd version 2.11.
+ * Copyright 2013-2025 by the authors as indicated in the original release,
+ * and subsequent authors as per GitHub transaction log.
+ *
+ * OB-Xf is released under the GNU General Public Licence v3 or later
+ * (GPL-3.0-or-later). The license is found in the file "LICENSE"
+ * in the root of this repository or at:
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * Source code is available at https://github.com/surge-synthesizer/OB-Xf
+ */
+
+#include "PatchFolderIndex.h"
+
+#include <cstring>
+
+bool PatchFolderIndex::load(const juce::File &indexFile)
+{
+    if (!indexFile.existsAsFile())
+    {
+        return false;
+    }
+
+    juce::MemoryMappedFile mapped(indexFile, juce::MemoryMappedFile::readOnly);
+
+    if (mapped.getData() == nullptr || mapped.getSize() < sizeof(magic) + 8 ||
+        std::memcmp(mapped.getData(), magic, sizeof(magic)) != 0)
+    {
+        return false;
+    }
+
+    juce::MemoryInputStream in(mapped.getData(), mapped.getSize(), false);
+    in.skipNextBytes(sizeof(magic));
+
+    if (in.readInt() != version)
+    {
+        return false;
+    }
+
+    std::unordered_map<juce::String, Folder> loaded;
+    const auto numFolders = in.readInt();
+
+    for (int f = 0; f < numFolders; ++f)
+    {
+        if (in.isExhausted())
+        {
+            return false;
+        }
+
+        auto path = in.readString();
+        Folder folder;
+        folder.modificationTime = in.readInt64();
+
+        const auto numEntries = in.readInt();
+
+        if (numEntries < 0 || in.getNumBytesRemaining() < numEntries)
+        {
+            return false;
+        }
+
+        folder.entries.resize(static_cast<size_t>(numEntries));
+
+        for (auto &e : folder.entries)
+        {
+            e.isFolder = in.readBool();
+            e.name = in.readString();
+        }
+
+        loaded.emplace(std::move(path), std::move(folder));
+    }
+
+    folders = std::move(loaded);
+    dirty = false;
+
+    return true;
+}
+
+bool PatchFolderIndex::save(const juce::File &indexFile) const
+{
+    // Write aside and move into place, so another instance never maps a half written file
+    juce::TemporaryFile temp(indexFile);
+
+    {
+        juce::FileOutputStream out(temp.getFile());
+
+        if (!out.openedOk())
+        {
+            return false;
+        }
+
+        out.write(magic, sizeof(magic));
+        out.writeInt(version);
+        out.writeInt(static_cast<int>(folders.size()));
+
+        for (const auto &[path, folder] : folders)
+        {
+            out.writeString(path);
+            out.writeInt64(folder.modificationTime);
+            out.writeInt(static_cast<int>(folder.entries.size()));
+
+            for (const auto &e : folder.entries)
+            {
+                out.writeBool(e.isFolder);
+                out.writeString(e.name);
+            }
+        }
+
+        out.flush();
+
+        if (out.getStatus().failed())
+        {
+            return false;
+        }
+    }
+
+    return temp.overwriteTargetFileWithTemporary();
+}
+
+void PatchFolderIndex::beginScan() { visited.clear(); }
+
+void PatchFolderIndex::endScan()
+{
+    if (cancelFlag && cancelFlag->load())
+    {
+        return;
+    }
+
+    for (auto it = folders.begin(); it != folders.end();)
+    {
+        if (visited.count(it->first) == 0)
+        {
+            it = folders.erase(it);
+            dirty = true;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+const PatchFolderIndex::Folder &PatchFolderIndex::listFolder(const juce::File &folder,
+                                                             bool trustIndex)
+{
+    const auto path = folder.getFullPathName();
+    visited.insert(path);
+
+    auto it = folders.find(path);
+
+    if (it != folders.end() && trustIndex)
+    {
+        return it->second;
+    }
+
+    if (cancelFlag && cancelFlag->load())
+    {
+        static const Folder empty;
+        return it != folders.end() ? it->second : empty;
+    }
+
+    const auto mtime = folder.getLastModificationTime().toMilliseconds();
+
+    if (it != folders.end() && it->second.modificationTime == mtime)
+    {
+        return it->second;
+    }
+
+    Folder listing;
+    listing.modificationTime = mtime;
+
+    for (const auto &kid : folder.findChildFiles(juce::File::findFilesAndDirectories, false))
+    {
+        if (kid.isDirectory())
+        {
+            listing.entries.push_back({kid.getFileName(), true});
+        }
+        else if (kid.getFileExtension().toLowerCase() == ".fxp")
+        {
+            listing.entries.push_back({kid.getFileName(), false});
+        }
+    }
+
+    dirty = true;
+
+    auto &res = folders[path];
+    res = std::move(listing);
+
+    return res;
+}
@@ -0,0 +1,86 @@
+/*
+ * OB-Xd was originally written by Vadim Filatov, and then a version
+ * was released under the GPL3 at https://github.com/reales/OB-Xd.
+ * Subsequently, the product was continued by DiscoDSP and the copyright
+ * holders as an excellent closed source product.
+ *
+ * This repository is a successor to OB-Xd version 2.11.
+ * Copyright 2013-2025 by the authors as indicated in the original release,
+ * and subsequent authors as per GitHub transaction log.
+ *
+ * OB-Xf is released under the GNU General Public Licence v3 or later
+ * (GPL-3.0-or-later). The license is found in the file "LICENSE"
+ * in the root of this repository or at:
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * Source code is available at https://github.com/surge-synthesizer/OB-Xf
+ */
+
+#ifndef OBXF_SRC_UTILITIES_PATCHFOLDERINDEX_H
+#define OBXF_SRC_UTILITIES_PATCHFOLDERINDEX_H
+
+#include <atomic>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <juce_core/juce_core.h>
+
+/*
+ * Remembers the listing (subfolders and .fxp files) of every patch folder we have
+ * scanned, keyed by the folder's modification time. Adding, removing or renaming a
+ * file touches its folder's mtime, so an unchanged mtime means the listing is still
+ * good and the folder doesn't need to be enumerated again.
+ *
+ * The index is persisted to disk so that later instances (and later sessions) only
+ * enumerate the folders that changed since.
+ */
+class PatchFolderIndex
+{
+  public:
+    struct Entry
+    {
+        juce::String name;
+        bool isFolder{false};
+    };
+
+    struct Folder
+    {
+        juce::int64 modificationTime{0};
+        std::vector<Entry> entries;
+    };
+
+    bool load(const juce::File &indexFile);
+    bool save(const juce::File &indexFile) const;
+
+    // Call around a full walk of the patch folders, so entries for folders which
+    // no longer exist get dropped at the end
+    void beginScan();
+    void endScan();
+
+    /*
+     * Returns the listing of a folder. With trustIndex, a folder already in the index
+     * is returned without touching the disk at all; otherwise its mtime is checked and
+     * the folder is enumerated again if it changed.
+     */
+    const Folder &listFolder(const juce::File &folder, bool trustIndex);
+
+    bool isEmpty() const { return folders.empty(); }
+
+    // Whether any listing changed since the index was loaded or last saved
+    bool isDirty() const { return dirty; }
+    void setDirty(bool d) { dirty = d; }
+
+    // Checked between folders so a long scan can be abandoned
+    std::atomic<bool> *cancelFlag{nullptr};
+
+  private:
+    static constexpr char magic[4] = {'O', 'B', 'X', 'I'};
+    static constexpr int version{1};
+
+    std::unordered_map<juce::String, Folder> folders;
+    std::unordered_set<juce::String> visited;
+    bool dirty{false};
+};
+
+#endif // OBXF_SRC_UTILITIES_PATCHFOLDERINDEX_H
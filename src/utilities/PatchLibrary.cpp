@@ -0,0 +1,92 @@
+/*
+ * OB-Xd was originally written by Vadim Filatov, and then a version
+ * was released under the GPL3 at https://github.com/reales/OB-Xd.
+ * Subsequently, the product was continued by DiscoDSP and the copyright
+ * holders as an excellent closed source product.
+ *
+ * This repository is a successor to OB-Xd version 2.11.
+ * Copyright 2013-2025 by the authors as indicated in the original release,
+ * and subsequent authors as per GitHub transaction log.
+ *
+ * OB-Xf is released under the GNU General Public Licence v3 or later
+ * (GPL-3.0-or-later). The license is found in the file "LICENSE"
+ * in the root of this repository or at:
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * Source code is available at https://github.com/surge-synthesizer/OB-Xf
+ */
+
+#include "PatchLibrary.h"
+
+std::shared_ptr<const PatchLibrary::values_t> PatchLibrary::get(const juce::File &fxpFile) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (const auto it = rows.find(fxpFile.getFullPathName()); it != rows.end())
+    {
+        return it->second.values;
+    }
+
+    return nullptr;
+}
+
+void PatchLibrary::update(const std::vector<juce::File> &files, const std::atomic<bool> *cancel)
+{
+    rows_t prior;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        prior = rows;
+    }
+
+    // decode outside the lock, so the mutator keeps reading the previous rows meanwhile
+    rows_t next;
+    next.reserve(files.size());
+
+    for (const auto &file : files)
+    {
+        const auto path = file.getFullPathName();
+        const auto it = prior.find(path);
+
+        if (cancel && cancel->load())
+        {
+            // keep what we had for the rest, it is as good as it was before
+            if (it != prior.end())
+            {
+                next.emplace(path, it->second);
+            }
+
+            continue;
+        }
+
+        Row r;
+        r.modificationTime = file.getLastModificationTime().toMilliseconds();
+        r.size = file.getSize();
+
+        if (it != prior.end() && it->second.modificationTime == r.modificationTime &&
+            it->second.size == r.size)
+        {
+            r.values = it->second.values;
+        }
+        else
+        {
+            auto values = std::make_shared<values_t>();
+
+            if (decoder && decoder(file, *values))
+            {
+                r.values = std::move(values);
+            }
+        }
+
+        next.emplace(path, std::move(r));
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    rows = std::move(next);
+}
+
+size_t PatchLibrary::numDecoded() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return rows.size();
+}
@@ -0,0 +1,75 @@
+/*
+ * OB-Xd was originally written by Vadim Filatov, and then a version
+ * was released under the GPL3 at https://github.com/reales/OB-Xd.
+ * Subsequently, the product was continued by DiscoDSP and the copyright
+ * holders as an excellent closed source product.
+ *
+ * This repository is a successor to OB-Xd version 2.11.
+ * Copyright 2013-2025 by the authors as indicated in the original release,
+ * and subsequent authors as per GitHub transaction log.
+ *
+ * OB-Xf is released under the GNU General Public Licence v3 or later
+ * (GPL-3.0-or-later). The license is found in the file "LICENSE"
+ * in the root of this repository or at:
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * Source code is available at https://github.com/surge-synthesizer/OB-Xf
+ */
+
+#ifndef OBXF_SRC_UTILITIES_PATCHLIBRARY_H
+#define OBXF_SRC_UTILITIES_PATCHLIBRARY_H
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <juce_core/juce_core.h>
+
+/*
+ * Patches decoded into dense value vectors in ParameterList order, for the patch mutator.
+ * The whole library is decoded on the patch scan thread, next to the metadata index, and
+ * afterwards only patches whose file changed are decoded again. Lookups never touch the
+ * disk, so the mutator can pick from it freely on the message thread. Rows are immutable
+ * once decoded and can be handed out freely.
+ */
+class PatchLibrary
+{
+  public:
+    using values_t = std::vector<float>;
+    using decoder_t = std::function<bool(const juce::File &, values_t &)>;
+
+    explicit PatchLibrary(decoder_t d) : decoder(std::move(d)) {}
+
+    // nullptr if the patch has not been decoded (yet), or could not be read
+    std::shared_ptr<const values_t> get(const juce::File &fxpFile) const;
+
+    /*
+     * Brings the library in line with these files: new or modified patches are decoded,
+     * patches no longer listed are dropped. Reads the disk, so call it from a worker.
+     * Whatever was decoded before a cancel is still published.
+     */
+    void update(const std::vector<juce::File> &files, const std::atomic<bool> *cancel = nullptr);
+
+    size_t numDecoded() const;
+
+  private:
+    struct Row
+    {
+        juce::int64 modificationTime{0};
+        juce::int64 size{0};
+        // nullptr when the patch could not be decoded, so it isn't tried again until it changes
+        std::shared_ptr<const values_t> values;
+    };
+
+    using rows_t = std::unordered_map<juce::String, Row>;
+
+    decoder_t decoder;
+
+    mutable std::mutex mutex;
+    rows_t rows;
+};
+
+#endif // OBXF_SRC_UTILITIES_PATCHLIBRARY_H
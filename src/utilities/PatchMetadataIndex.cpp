@@ -0,0 +1,311 @@
+/*
+ * OB-Xd was originally written by Vadim Filatov, and then a version
+ * was released under the GPL3 at https://github.com/reales/OB-Xd.
+ * Subsequently, the product was continued by DiscoDSP and the copyright
+ * holders as an excellent closed source product.
+ *
+ * This repository is a successor to OB-Xd version 2.11.
+ * Copyright 2013-2025 by the authors as indicated in the original release,
+ * and subsequent authors as per GitHub transaction log.
+ *
+ * OB-Xf is released under the GNU General Public Licence v3 or later
+ * (GPL-3.0-or-later). The license is found in the file "LICENSE"
+ * in the root of this repository or at:
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * Source code is available at https://github.com/surge-synthesizer/OB-Xf
+ */
+
+#include "PatchMetadataIndex.h"
+
+#include <cstring>
+#include <unordered_set>
+
+#include "ObxdImporter.h"
+#include "StateManager.h"
+
+std::vector<int> PatchMetadataIndex::Table::search(const juce::String &query, int fieldMask,
+                                                   bool prefixOnly, size_t maxResults) const
+{
+    std::vector<int> res;
+    const auto q = query.trim().toLowerCase();
+
+    for (size_t row = 0; row < size(); ++row)
+    {
+        bool hit = q.isEmpty();
+
+        for (int f = 0; f < numFields && !hit; ++f)
+        {
+            if (fieldMask & fieldBit(static_cast<Field>(f)))
+            {
+                const auto &v = folded[f][row];
+                hit = prefixOnly ? v.startsWith(q) : v.contains(q);
+            }
+        }
+
+        if (hit)
+        {
+            res.push_back(static_cast<int>(row));
+
+            if (maxResults > 0 && res.size() >= maxResults)
+            {
+                break;
+            }
+        }
+    }
+
+    return res;
+}
+
+bool PatchMetadataIndex::readMetadata(const juce::File &fxp, fields_t &out)
+{
+    juce::MemoryBlock mb;
+
+    if (!fxp.loadFileAsData(mb))
+    {
+        return false;
+    }
+
+    if (ObxdImporter::isOBXdData(mb.getData(), mb.getSize()))
+    {
+        Program program;
+
+        if (!ObxdImporter::importSingleOnto(mb.getData(), mb.getSize(), program))
+        {
+            return false;
+        }
+
+        out[Name] = program.getName();
+        out[Author] = program.getAuthor();
+        out[License] = program.getLicense();
+        out[Category] = program.getCategory();
+        out[Project] = program.getProject();
+
+        return true;
+    }
+
+    const void *data = nullptr;
+    int sizeInBytes = 0;
+
+    if (!StateManager::getChunkFromFxpData(mb.getData(), mb.getSize(), data, sizeInBytes))
+    {
+        return false;
+    }
+
+    const auto e = juce::AudioProcessor::getXmlFromBinary(data, sizeInBytes);
+
+    if (!e)
+    {
+        return false;
+    }
+
+    // same defaults as StateManager::populateProgramFromXml
+    out[Name] = e->getStringAttribute("programName", "Init");
+    out[Author] = e->getStringAttribute("author", "");
+    out[License] = e->getStringAttribute("license", "");
+    out[Category] = e->getStringAttribute("category", "");
+    out[Project] = e->getStringAttribute("project", "");
+
+    return true;
+}
+
+std::shared_ptr<const PatchMetadataIndex::Table>
+PatchMetadataIndex::update(const std::vector<juce::File> &files, bool trustIndex,
+                           const std::atomic<bool> *cancel)
+{
+    auto table = std::make_shared<Table>();
+
+    for (auto &c : table->columns)
+    {
+        c.reserve(files.size());
+    }
+
+    std::unordered_set<juce::String> seen;
+    seen.reserve(files.size());
+
+    for (const auto &file : files)
+    {
+        const auto path = file.getFullPathName();
+        seen.insert(path);
+
+        auto it = records.find(path);
+        const bool canCheck = !(cancel && cancel->load());
+
+        if (canCheck && !(trustIndex && it != records.end()))
+        {
+            const auto mtime = file.getLastModificationTime().toMilliseconds();
+            const auto size = file.getSize();
+
+            if (it == records.end() || it->second.modificationTime != mtime ||
+                it->second.size != size)
+            {
+                Record r;
+                r.modificationTime = mtime;
+                r.size = size;
+
+                if (!readMetadata(file, r.fields))
+                {
+                    r.fields[Name] = file.getFileNameWithoutExtension();
+                }
+
+                it = records.insert_or_assign(path, std::move(r)).first;
+                dirty = true;
+            }
+        }
+
+        for (int f = 0; f < numFields; ++f)
+        {
+            table->columns[f].push_back(it != records.end() ? it->second.fields[f]
+                                                            : juce::String());
+        }
+    }
+
+    if (!(cancel && cancel->load()))
+    {
+        for (auto it = records.begin(); it != records.end();)
+        {
+            if (seen.count(it->first) == 0)
+            {
+                it = records.erase(it);
+                dirty = true;
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    for (int f = 0; f < numFields; ++f)
+    {
+        table->folded[f].reserve(table->columns[f].size());
+
+        for (const auto &v : table->columns[f])
+        {
+            table->folded[f].push_back(v.toLowerCase());
+        }
+    }
+
+    return table;
+}
+
+bool PatchMetadataIndex::load(const juce::File &indexFile)
+{
+    if (!indexFile.existsAsFile())
+    {
+        return false;
+    }
+
+    juce::MemoryMappedFile mapped(indexFile, juce::MemoryMappedFile::readOnly);
+
+    if (mapped.getData() == nullptr || mapped.getSize() < sizeof(magic) + 8 ||
+        std::memcmp(mapped.getData(), magic, sizeof(magic)) != 0)
+    {
+        return false;
+    }
+
+    juce::MemoryInputStream in(mapped.getData(), mapped.getSize(), false);
+    in.skipNextBytes(sizeof(magic));
+
+    if (in.readInt() != version)
+    {
+        return false;
+    }
+
+    const auto n = in.readInt();
+
+    if (n < 0 || in.getNumBytesRemaining() < static_cast<juce::int64>(n) * 16)
+    {
+        return false;
+    }
+
+    // columns: paths, mtimes, sizes, then one column per field
+    std::vector<juce::String> paths(static_cast<size_t>(n));
+    std::vector<Record> loaded(static_cast<size_t>(n));
+
+    for (auto &p : paths)
+    {
+        p = in.readString();
+    }
+
+    for (auto &r : loaded)
+    {
+        r.modificationTime = in.readInt64();
+    }
+
+    for (auto &r : loaded)
+    {
+        r.size = in.readInt64();
+    }
+
+    for (int f = 0; f < numFields; ++f)
+    {
+        for (auto &r : loaded)
+        {
+            r.fields[f] = in.readString();
+        }
+    }
+
+    records.clear();
+    records.reserve(paths.size());
+
+    for (size_t i = 0; i < paths.size(); ++i)
+    {
+        records.emplace(std::move(paths[i]), std::move(loaded[i]));
+    }
+
+    dirty = false;
+
+    return true;
+}
+
+bool PatchMetadataIndex::save(const juce::File &indexFile) const
+{
+    // Write aside and move into place, so another instance never maps a half written file
+    juce::TemporaryFile temp(indexFile);
+
+    {
+        juce::FileOutputStream out(temp.getFile());
+
+        if (!out.openedOk())
+        {
+            return false;
+        }
+
+        out.write(magic, sizeof(magic));
+        out.writeInt(version);
+        out.writeInt(static_cast<int>(records.size()));
+
+        for (const auto &[path, r] : records)
+        {
+            out.writeString(path);
+        }
+
+        for (const auto &[path, r] : records)
+        {
+            out.writeInt64(r.modificationTime);
+        }
+
+        for (const auto &[path, r] : records)
+        {
+            out.writeInt64(r.size);
+        }
+
+        for (int f = 0; f < numFields; ++f)
+        {
+            for (const auto &[path, r] : records)
+            {
+                out.writeString(r.fields[f]);
+            }
+        }
+
+        out.flush();
+
+        if (out.getStatus().failed())
+        {
+            return false;
+        }
+    }
+
+    return temp.overwriteTargetFileWithTemporary();
+}
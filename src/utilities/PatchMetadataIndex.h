@@ -0,0 +1,104 @@
+/*
+ * OB-Xd was originally written by Vadim Filatov, and then a version
+ * was released under the GPL3 at https://github.com/reales/OB-Xd.
+ * Subsequently, the product was continued by DiscoDSP and the copyright
+ * holders as an excellent closed source product.
+ *
+ * This repository is a successor to OB-Xd version 2.11.
+ * Copyright 2013-2025 by the authors as indicated in the original release,
+ * and subsequent authors as per GitHub transaction log.
+ *
+ * OB-Xf is released under the GNU General Public Licence v3 or later
+ * (GPL-3.0-or-later). The license is found in the file "LICENSE"
+ * in the root of this repository or at:
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * Source code is available at https://github.com/surge-synthesizer/OB-Xf
+ */
+
+#ifndef OBXF_SRC_UTILITIES_PATCHMETADATAINDEX_H
+#define OBXF_SRC_UTILITIES_PATCHMETADATAINDEX_H
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <juce_core/juce_core.h>
+
+/*
+ * Name, author, license, category and project of every patch, read once per FXP
+ * and remembered by file modification time and size. Persisted as a columnar file
+ * next to the patch folder index, so a patch is only ever parsed again when it
+ * changes on disk.
+ */
+class PatchMetadataIndex
+{
+  public:
+    enum Field
+    {
+        Name = 0,
+        Author,
+        License,
+        Category,
+        Project,
+
+        numFields
+    };
+
+    using fields_t = std::array<juce::String, numFields>;
+
+    static constexpr int fieldBit(Field f) { return 1 << f; }
+    static constexpr int allFields{(1 << numFields) - 1};
+
+    /*
+     * Immutable snapshot with one row per patch, in the same order as the patch list it
+     * was built for, so row n is patchesAsLinearList[n]. Lowercased copies of every
+     * column are kept alongside so searching never allocates per row.
+     */
+    struct Table
+    {
+        std::array<std::vector<juce::String>, numFields> columns;
+        std::array<std::vector<juce::String>, numFields> folded;
+
+        size_t size() const { return columns[Name].size(); }
+        const juce::String &get(Field f, size_t row) const { return columns[f][row]; }
+
+        // Rows where any of the masked fields contains (or starts with) the query, ignoring case
+        std::vector<int> search(const juce::String &query, int fieldMask = allFields,
+                                bool prefixOnly = false, size_t maxResults = 0) const;
+    };
+
+    bool load(const juce::File &indexFile);
+    bool save(const juce::File &indexFile) const;
+
+    /*
+     * Builds a table for the given patch files. Files which are new, or whose mtime or
+     * size changed, are parsed; with trustIndex files already known are not even looked
+     * at. Records for files no longer in the list are dropped.
+     */
+    std::shared_ptr<const Table> update(const std::vector<juce::File> &files, bool trustIndex,
+                                        const std::atomic<bool> *cancel = nullptr);
+
+    bool isDirty() const { return dirty; }
+    void setDirty(bool d) { dirty = d; }
+
+    static bool readMetadata(const juce::File &fxp, fields_t &out);
+
+  private:
+    static constexpr char magic[4] = {'O', 'B', 'X', 'M'};
+    static constexpr int version{1};
+
+    struct Record
+    {
+        juce::int64 modificationTime{0};
+        juce::int64 size{0};
+        fields_t fields;
+    };
+
+    std::unordered_map<juce::String, Record> records;
+    bool dirty{false};
+};
+
+#endif // OBXF_SRC_UTILITIES_PATCHMETADATAINDEX_H
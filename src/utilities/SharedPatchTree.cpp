@@ -0,0 +1,285 @@
+/*
+ * OB-Xd was originally written by Vadim Filatov, and then a version
+ * was released under the GPL3 at https://github.com/reales/OB-Xd.
+ * Subsequently, the product was continued by DiscoDSP and the copyright
+ * holders as an excellent closed source product.
+ *
+ * This repository is a successor to OB-Xd version 2.11.
+ * Copyright 2013-2025 by the authors as indicated in the original release,
+ * and subsequent authors as per GitHub transaction log.
+ *
+ * OB-Xf is released under the GNU General Public Licence v3 or later
+ * (GPL-3.0-or-later). The license is found in the file "LICENSE"
+ * in the root of this repository or at:
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * Source code is available at https://github.com/surge-synthesizer/OB-Xf
+ */
+
+#include "SharedPatchTree.h"
+
+#include <juce_events/juce_events.h>
+
+#include "SharedResources.h"
+#include "StateManager.h"
+
+std::shared_ptr<SharedPatchTree> SharedPatchTree::acquire(const Utils::PatchRoots &roots,
+                                                          const juce::File &cacheFolder,
+                                                          bool &created)
+{
+    std::string key = cacheFolder.getFullPathName().toStdString();
+
+    for (const auto &[lt, folder] : roots)
+    {
+        key += "|" + folder.getFullPathName().toStdString();
+    }
+
+    created = false;
+
+    return obxf::SharedResources::acquire<SharedPatchTree>(key, [&]() {
+        created = true;
+        return std::make_shared<SharedPatchTree>(roots, cacheFolder);
+    });
+}
+
+SharedPatchTree::SharedPatchTree(Utils::PatchRoots r, juce::File cf)
+    : roots(std::move(r)), cacheFolder(std::move(cf)),
+      library([](const juce::File &f, PatchLibrary::values_t &out) {
+          juce::MemoryBlock mb;
+          return f.loadFileAsData(mb) && StateManager::decodeProgramValues(mb, out);
+      })
+{
+    folderIndex.cancelFlag = &cancelScan;
+
+    if (folderIndex.load(getFolderIndexFile()))
+    {
+        auto t = std::make_shared<Utils::PatchTree>(
+            Utils::buildPatchTree(roots, folderIndex, true));
+
+        // Without a metadata index every patch would have to be parsed here, leave that
+        // to the background scan instead
+        if (metadataIndex.load(getMetadataFile()))
+        {
+            attachMetadata(*t, true);
+        }
+
+        tree = std::move(t);
+    }
+}
+
+SharedPatchTree::~SharedPatchTree() { stopBackgroundScan(); }
+
+SharedPatchTree::tree_t SharedPatchTree::current() const
+{
+    std::lock_guard<std::mutex> lock(treeMutex);
+    return tree;
+}
+
+int SharedPatchTree::addListener(listener_t l)
+{
+    std::lock_guard<std::recursive_mutex> lock(listenerMutex);
+    listeners[nextListenerId] = std::move(l);
+
+    return nextListenerId++;
+}
+
+void SharedPatchTree::removeListener(int id)
+{
+    std::lock_guard<std::recursive_mutex> lock(listenerMutex);
+    listeners.erase(id);
+}
+
+void SharedPatchTree::publish(const tree_t &t)
+{
+    {
+        std::lock_guard<std::mutex> lock(treeMutex);
+        tree = t;
+    }
+
+    std::lock_guard<std::recursive_mutex> lock(listenerMutex);
+
+    for (const auto &[id, l] : listeners)
+    {
+        l(t);
+    }
+}
+
+std::vector<juce::File> SharedPatchTree::patchFiles(const Utils::PatchTree &t)
+{
+    std::vector<juce::File> files;
+    files.reserve(t.linearList.size());
+
+    for (const auto &node : t.linearList)
+    {
+        files.push_back(node->file);
+    }
+
+    return files;
+}
+
+std::shared_ptr<const PreparedProgramBank::programs_t>
+SharedPatchTree::prepareMidiPrograms(const Utils::PatchTree &t, const std::atomic<bool> *cancel)
+{
+    auto programs = std::make_shared<PreparedProgramBank::programs_t>();
+
+    if (t.firstMidiProgram > -1 && t.numMidiPrograms > 0)
+    {
+        programs->reserve(static_cast<size_t>(t.numMidiPrograms));
+
+        for (int i = 0; i < t.numMidiPrograms; ++i)
+        {
+            const auto idx = static_cast<size_t>(t.firstMidiProgram + i);
+
+            if (idx >= t.linearList.size())
+            {
+                break;
+            }
+
+            if (cancel && cancel->load())
+            {
+                return nullptr;
+            }
+
+            const auto &node = t.linearList[idx];
+            juce::MemoryBlock mb;
+            PreparedProgram prog;
+
+            if (!node->file.loadFileAsData(mb) || !StateManager::decodePreparedProgram(mb, prog))
+            {
+                OBLOG(patches, "Unable to prepare MIDI program " << node->file.getFullPathName());
+                prog.setFrom(Program(), VoiceMatrix());
+            }
+
+            prog.patchIndex = node->index;
+            programs->push_back(std::move(prog));
+        }
+    }
+
+    OBLOG(patches, "Prepared " << programs->size() << " MIDI programs");
+    return programs;
+}
+
+bool SharedPatchTree::attachMetadata(Utils::PatchTree &t, bool trustIndex)
+{
+    const auto files = patchFiles(t);
+
+    t.metadata = metadataIndex.update(files, trustIndex, &cancelScan);
+
+    if (!metadataIndex.isDirty())
+    {
+        return false;
+    }
+
+    if (!trustIndex && metadataIndex.save(getMetadataFile()))
+    {
+        metadataIndex.setDirty(false);
+    }
+
+    return true;
+}
+
+void SharedPatchTree::stopBackgroundScan()
+{
+    if (scanThread.joinable())
+    {
+        cancelScan = true;
+        scanThread.join();
+    }
+
+    cancelScan = false;
+}
+
+void SharedPatchTree::rescan()
+{
+    stopBackgroundScan();
+
+    auto t = std::make_shared<Utils::PatchTree>();
+
+    {
+        std::lock_guard<std::mutex> lock(indexMutex);
+
+        *t = Utils::buildPatchTree(roots, folderIndex, false);
+
+        if (folderIndex.isDirty() && folderIndex.save(getFolderIndexFile()))
+        {
+            folderIndex.setDirty(false);
+        }
+
+        attachMetadata(*t, false);
+    }
+
+    library.update(patchFiles(*t));
+    t->midiPrograms = prepareMidiPrograms(*t, nullptr);
+
+    publish(t);
+}
+
+void SharedPatchTree::rescanInBackground()
+{
+    // Without a message loop (e.g. the Python module) there is nobody to publish to
+    if (juce::MessageManager::getInstanceWithoutCreating() == nullptr)
+    {
+        rescan();
+        return;
+    }
+
+    stopBackgroundScan();
+
+    // nothing listed yet, or a tree from the index without its MIDI programs, so whatever
+    // we find is news
+    const auto listed = current();
+    const bool alwaysPublish = listed == nullptr || listed->midiPrograms == nullptr;
+
+    scanThread = std::thread([this, alwaysPublish, self = weak_from_this()]() {
+        juce::Thread::setCurrentThreadName("OB-Xf Patch Scan");
+
+        std::unique_lock<std::mutex> lock(indexMutex);
+
+        auto t = std::make_shared<Utils::PatchTree>(
+            Utils::buildPatchTree(roots, folderIndex, false));
+
+        if (cancelScan)
+        {
+            return;
+        }
+
+        bool changed = folderIndex.isDirty();
+
+        if (changed && folderIndex.save(getFolderIndexFile()))
+        {
+            folderIndex.setDirty(false);
+        }
+
+        changed = attachMetadata(*t, false) || changed;
+
+        if (cancelScan)
+        {
+            return;
+        }
+
+        lock.unlock();
+
+        t->midiPrograms = prepareMidiPrograms(*t, &cancelScan);
+
+        if (cancelScan)
+        {
+            return;
+        }
+
+        const auto files = patchFiles(*t);
+
+        if (changed || alwaysPublish)
+        {
+            juce::MessageManager::callAsync([self, t = tree_t(std::move(t))]() {
+                if (const auto live = self.lock())
+                {
+                    live->publish(t);
+                }
+            });
+        }
+
+        // the tree is shown first, the mutator picks up the decoded patches as they land;
+        // this also runs when nothing changed, as the library starts out empty every process
+        library.update(files, &cancelScan);
+    });
+}
@@ -0,0 +1,111 @@
+/*
+ * OB-Xd was originally written by Vadim Filatov, and then a version
+ * was released under the GPL3 at https://github.com/reales/OB-Xd.
+ * Subsequently, the product was continued by DiscoDSP and the copyright
+ * holders as an excellent closed source product.
+ *
+ * This repository is a successor to OB-Xd version 2.11.
+ * Copyright 2013-2025 by the authors as indicated in the original release,
+ * and subsequent authors as per GitHub transaction log.
+ *
+ * OB-Xf is released under the GNU General Public Licence v3 or later
+ * (GPL-3.0-or-later). The license is found in the file "LICENSE"
+ * in the root of this repository or at:
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * Source code is available at https://github.com/surge-synthesizer/OB-Xf
+ */
+
+#ifndef OBXF_SRC_UTILITIES_SHAREDPATCHTREE_H
+#define OBXF_SRC_UTILITIES_SHAREDPATCHTREE_H
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "Utils.h"
+#include "PatchFolderIndex.h"
+#include "PatchMetadataIndex.h"
+#include "PatchLibrary.h"
+#include "PreparedProgram.h"
+
+/*
+ * The patch tree, its folder and metadata indices, the decoded patch library and the
+ * prepared MIDI program bank, held
+ * once per process for every instance looking at the same patch folders. Trees are
+ * immutable once published; each instance registers a listener and is handed the new
+ * tree whenever any of them rescans.
+ */
+class SharedPatchTree : public std::enable_shared_from_this<SharedPatchTree>
+{
+  public:
+    using tree_t = std::shared_ptr<const Utils::PatchTree>;
+    using listener_t = std::function<void(const tree_t &)>;
+
+    /*
+     * The shared tree for these roots. The instance which caused it to be created gets
+     * created = true, and is the one which should check the disk behind the index.
+     */
+    static std::shared_ptr<SharedPatchTree> acquire(const Utils::PatchRoots &roots,
+                                                    const juce::File &cacheFolder,
+                                                    bool &created);
+
+    // Loads whatever the on-disk indices remember, without touching the patch folders
+    SharedPatchTree(Utils::PatchRoots roots, juce::File cacheFolder);
+    ~SharedPatchTree();
+
+    // nullptr until something has been scanned or loaded from the index
+    tree_t current() const;
+
+    // Rescans right away, re-enumerating only the folders which changed
+    void rescan();
+    // Rescans on a worker thread and publishes the new tree on the message thread,
+    // but only if something actually changed on disk
+    void rescanInBackground();
+
+    int addListener(listener_t l);
+    void removeListener(int id);
+
+    // Values of a patch file in ParameterList order, without any instance's parameter locks.
+    // Decoded by the rescans, so nullptr for a patch the scan hasn't got to yet
+    std::shared_ptr<const PatchLibrary::values_t> getDecodedPatch(const juce::File &fxpFile)
+    {
+        return library.get(fxpFile);
+    }
+
+  private:
+    void publish(const tree_t &tree);
+    static std::vector<juce::File> patchFiles(const Utils::PatchTree &tree);
+    // Reads and decodes the tree's MIDI programs, nullptr if cancelled part way
+    static std::shared_ptr<const PreparedProgramBank::programs_t>
+    prepareMidiPrograms(const Utils::PatchTree &tree, const std::atomic<bool> *cancel);
+    // call with indexMutex held, returns whether the metadata changed
+    bool attachMetadata(Utils::PatchTree &tree, bool trustIndex);
+    void stopBackgroundScan();
+
+    juce::File getFolderIndexFile() const { return cacheFolder.getChildFile("PatchIndex.cache"); }
+    juce::File getMetadataFile() const { return cacheFolder.getChildFile("PatchMetadata.cache"); }
+
+    const Utils::PatchRoots roots;
+    const juce::File cacheFolder;
+
+    PatchFolderIndex folderIndex;
+    PatchMetadataIndex metadataIndex;
+    std::mutex indexMutex;
+    std::thread scanThread;
+    std::atomic<bool> cancelScan{false};
+
+    mutable std::mutex treeMutex;
+    tree_t tree;
+
+    std::recursive_mutex listenerMutex;
+    std::map<int, listener_t> listeners;
+    int nextListenerId{0};
+
+    PatchLibrary library;
+};
+
+#endif // OBXF_SRC_UTILITIES_SHAREDPATCHTREE_H
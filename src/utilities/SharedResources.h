@@ -0,0 +1,141 @@
+/*
+ * OB-Xd was originally written by Vadim Filatov, and then a version
+ * was released under the GPL3 at https://github.com/reales/OB-Xd.
+ * Subsequently, the product was continued by DiscoDSP and the copyright
+ * holders as an excellent closed source product.
+ *
+ * This repository is a successor to OB-Xd version 2.11.
+ * Copyright 2013-2025 by the authors as indicated in the original release,
+ * and subsequent authors as per GitHub transaction log.
+ *
+ * OB-Xf is released under the GNU General Public Licence v3 or later
+ * (GPL-3.0-or-later). The license is found in the file "LICENSE"
+ * in the root of this repository or at:
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * Source code is available at https://github.com/surge-synthesizer/OB-Xf
+ */
+
+#ifndef OBXF_SRC_UTILITIES_SHAREDRESOURCES_H
+#define OBXF_SRC_UTILITIES_SHAREDRESOURCES_H
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+
+namespace obxf
+{
+
+/*
+ * Process wide registry of resources which every plugin instance would otherwise build
+ * for itself: the patch tree, parsed theme XML, decoded theme images. acquire() returns
+ * the live copy for a key if any instance still holds one, and builds it otherwise. The
+ * registry itself only keeps weak references, so a resource goes away with the last
+ * instance using it.
+ *
+ * Keys are scoped by type, so the same key can name a different resource of each type.
+ */
+class SharedResources
+{
+  public:
+    template <typename T>
+    static std::shared_ptr<T> acquire(const std::string &key,
+                                      const std::function<std::shared_ptr<T>()> &make)
+    {
+        auto &r = registry();
+        const auto typedKey = scopedKey<T>(key);
+
+        // recursive, since building a resource may acquire others
+        std::lock_guard<std::recursive_mutex> lock(r.mutex);
+
+        if (const auto it = r.entries.find(typedKey); it != r.entries.end())
+        {
+            if (auto live = it->second.lock())
+            {
+                return std::const_pointer_cast<T>(std::static_pointer_cast<const T>(live));
+            }
+        }
+
+        pruneExpired(r);
+
+        auto res = make();
+        r.entries[typedKey] = res;
+
+        return res;
+    }
+
+    // The next acquire builds the resource afresh; current holders keep what they have
+    template <typename T> static void invalidate(const std::string &key)
+    {
+        auto &r = registry();
+        std::lock_guard<std::recursive_mutex> lock(r.mutex);
+        r.entries.erase(scopedKey<T>(key));
+    }
+
+    // FNV-1a over some bytes, for resources keyed by their contents. Chain calls through
+    // seed to hash several pieces as one
+    static uint64_t hashContents(const void *data, size_t size,
+                                 uint64_t seed = 14695981039346656037ull)
+    {
+        auto h = seed;
+        const auto *bytes = static_cast<const uint8_t *>(data);
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            h = (h ^ bytes[i]) * 1099511628211ull;
+        }
+
+        return h;
+    }
+
+    // Number of resources still held by somebody
+    static size_t numLive()
+    {
+        auto &r = registry();
+        std::lock_guard<std::recursive_mutex> lock(r.mutex);
+        pruneExpired(r);
+
+        return r.entries.size();
+    }
+
+  private:
+    struct Registry
+    {
+        std::recursive_mutex mutex;
+        std::unordered_map<std::string, std::weak_ptr<const void>> entries;
+    };
+
+    static Registry &registry()
+    {
+        static Registry r;
+        return r;
+    }
+
+    template <typename T> static std::string scopedKey(const std::string &key)
+    {
+        return std::string(typeid(T).name()) + "|" + key;
+    }
+
+    static void pruneExpired(Registry &r)
+    {
+        for (auto it = r.entries.begin(); it != r.entries.end();)
+        {
+            if (it->second.expired())
+            {
+                it = r.entries.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+};
+
+} // namespace obxf
+
+#endif // OBXF_SRC_UTILITIES_SHAREDRESOURCES_H